@@ -1,15 +1,19 @@
 #pragma once
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <filesystem>
 #include "beatsaber-hook/shared/rapidjson.hpp"
+#include "CustomJSONData.hpp"
 
 namespace SongCore::Utils {
     struct CachedSongData {
         int directoryHash;
         std::optional<std::string> sha1 = std::nullopt;
         std::optional<float> songDuration = std::nullopt;
+        /// @brief the level details parsed from the info.dat, so later loads don't have to extract them again
+        std::shared_ptr<CustomJSONData::CustomSaveDataInfo::BasicCustomLevelDetails const> levelDetails = nullptr;
 
         /// @brief serializes the data to a rapidjson value using the provided allocator
         rapidjson::Value Serialize(rapidjson::Document::AllocatorType& allocator) const;
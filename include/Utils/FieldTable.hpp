@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace SongCore::Utils {
+    /// @brief one json member a field table knows how to read
+    template<typename Target, typename ValueT>
+    struct Field {
+        std::string_view name;
+        /// @brief reads the member value into the target
+        /// @return whether the value was usable
+        bool (*read)(Target& target, ValueT const& value);
+    };
+
+    /// @brief hashes an ascii key, the same for both utf8 and utf16 json strings
+    template<typename Ch>
+    constexpr uint32_t HashFieldName(Ch const* name, size_t length, uint32_t seed) {
+        uint32_t hash = 2166136261u ^ seed;
+        for (size_t i = 0; i < length; i++) {
+            hash ^= static_cast<uint32_t>(name[i]);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    /// @brief compile time table of json members for a struct. the member names are perfect hashed when the table is built,
+    /// so reading an object is one pass over its members with a single hash and compare per member
+    template<typename Target, typename ValueT, size_t N>
+    class FieldTable {
+        static_assert(N > 0 && N <= 64, "a field table holds between 1 and 64 fields");
+        static constexpr size_t SlotCount = std::bit_ceil(N * 2);
+        static constexpr uint8_t EmptySlot = 0xFF;
+
+        public:
+            using Mask = uint64_t;
+
+            consteval FieldTable(Field<Target, ValueT> const (&fields)[N]) {
+                for (size_t i = 0; i < N; i++) _fields[i] = fields[i];
+
+                // find a seed that gives every name its own slot
+                for (uint32_t seed = 0; seed < 100000; seed++) {
+                    if (TrySeed(seed)) return;
+                }
+                throw "no perfect hash found for the field table";
+            }
+
+            /// @brief reads every known member of the object into the target in a single pass
+            /// @return mask of the fields that were found and read successfully, see Bit
+            Mask Read(Target& target, ValueT const& object) const {
+                Mask found = 0;
+                if (!object.IsObject()) return found;
+
+                for (auto itr = object.MemberBegin(); itr != object.MemberEnd(); ++itr) {
+                    auto idx = Find(itr->name.GetString(), itr->name.GetStringLength());
+                    if (idx == EmptySlot) continue;
+                    if (_fields[idx].read(target, itr->value)) found |= Mask(1) << idx;
+                }
+
+                return found;
+            }
+
+            /// @brief the mask bit for the field with the given name
+            consteval Mask Bit(std::string_view name) const {
+                for (size_t i = 0; i < N; i++) {
+                    if (_fields[i].name == name) return Mask(1) << i;
+                }
+                throw "field is not in the table";
+            }
+        private:
+            consteval bool TrySeed(uint32_t seed) {
+                _slots.fill(EmptySlot);
+                for (size_t i = 0; i < N; i++) {
+                    auto slot = HashFieldName(_fields[i].name.data(), _fields[i].name.size(), seed) & (SlotCount - 1);
+                    if (_slots[slot] != EmptySlot) return false;
+                    _slots[slot] = static_cast<uint8_t>(i);
+                }
+                _seed = seed;
+                return true;
+            }
+
+            template<typename Ch>
+            uint8_t Find(Ch const* name, size_t length) const {
+                auto idx = _slots[HashFieldName(name, length, _seed) & (SlotCount - 1)];
+                if (idx == EmptySlot) return EmptySlot;
+
+                // names are ascii, so the code units compare directly for both encodings
+                auto expected = _fields[idx].name;
+                if (expected.size() != length) return EmptySlot;
+                for (size_t i = 0; i < length; i++) {
+                    if (static_cast<uint32_t>(name[i]) != static_cast<unsigned char>(expected[i])) return EmptySlot;
+                }
+                return idx;
+            }
+
+            std::array<Field<Target, ValueT>, N> _fields{};
+            std::array<uint8_t, SlotCount> _slots{};
+            uint32_t _seed = 0;
+    };
+
+    /// @brief builds a field table, the field count is deduced from the list
+    template<typename Target, typename ValueT, size_t N>
+    consteval FieldTable<Target, ValueT, N> MakeFieldTable(Field<Target, ValueT> const (&fields)[N]) {
+        return FieldTable<Target, ValueT, N>(fields);
+    }
+}
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <vector>
+#include <span>
 #include <string>
 #include <string_view>
 #include <filesystem>
@@ -9,8 +13,61 @@ namespace SongCore::Utils {
     std::vector<std::string> GetFolders(std::string_view path);
     std::vector<std::filesystem::path> GetFolders(std::filesystem::path path);
 
+    /// @brief read only view of a whole file. big files are memory mapped, small ones are read into a pooled buffer
+    class FileView {
+        public:
+            /// @brief files at least this big get memory mapped instead of read
+            static constexpr size_t MapThreshold = 64 * 1024;
+
+            /// @brief opens the file at path
+            /// @return the view, or nullopt if the file could not be opened or is not a regular file
+            static std::optional<FileView> Open(std::filesystem::path const& path);
+
+            FileView(FileView&& other) noexcept;
+            FileView& operator=(FileView&& other) noexcept;
+            FileView(FileView const&) = delete;
+            FileView& operator=(FileView const&) = delete;
+            ~FileView();
+
+            std::span<const uint8_t> bytes() const { return { _data, _size }; }
+            std::string_view chars() const { return { reinterpret_cast<char const*>(_data), _size }; }
+            size_t size() const { return _size; }
+            bool empty() const { return _size == 0; }
+            /// @brief whether the file is memory mapped rather than read into a buffer
+            bool mapped() const { return _mapping != nullptr; }
+        private:
+            FileView() = default;
+            void Release();
+
+            uint8_t const* _data = nullptr;
+            size_t _size = 0;
+            void* _mapping = nullptr;
+            std::vector<uint8_t> _buffer;
+    };
+
+    enum class TextEncoding {
+        UTF8,
+        UTF16LE,
+        UTF16BE
+    };
+
+    struct DetectedEncoding {
+        TextEncoding encoding = TextEncoding::UTF8;
+        /// @brief size of the byte order mark at the start of the data, 0 if there was none
+        size_t bomSize = 0;
+    };
+
+    /// @brief detects the encoding of text data from its BOM. without a BOM utf16 is detected from the zero bytes around the first character, which works for json since it always starts with ascii
+    DetectedEncoding DetectEncoding(std::span<const uint8_t> bytes);
+
+    /// @brief reads the file as utf16, decoding it from whatever encoding it was saved in
     std::u16string ReadText(std::string_view path);
     std::u16string ReadText(std::filesystem::path path);
 
-    const char* ReadBytes(std::string_view path, size_t& size_out);
+    /// @brief reads the file as utf8, skipping a BOM if present and converting utf16 files
+    std::string ReadUTF8Text(std::filesystem::path path);
+
+    /// @brief reads the raw bytes of the file
+    /// @return the file contents, empty if the file could not be read
+    std::vector<uint8_t> ReadBytes(std::filesystem::path const& path);
 }
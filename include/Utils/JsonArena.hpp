@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CustomJSONData.hpp"
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace SongCore::Utils {
+    /// @brief parses utf8 json into the calling thread's reusable arena, then copies the result into a document backed by a single right-sized block
+    /// @param json the text to parse
+    /// @param context what is being parsed, used when logging parse errors
+    /// @return the compacted document, or nullptr if parsing failed
+    std::shared_ptr<SongCore::CustomJSONData::DocumentUTF8> ParseCompactDocument(std::string_view json, std::string_view context);
+
+    /// @brief same as ParseCompactDocument, but parses in place. json is overwritten while parsing and should not be used afterwards
+    std::shared_ptr<SongCore::CustomJSONData::DocumentUTF8> ParseCompactDocumentInsitu(std::string& json, std::string_view context);
+
+    /// @brief writes the value back out as json text
+    std::string WriteJson(SongCore::CustomJSONData::ValueUTF8 const& value);
+}
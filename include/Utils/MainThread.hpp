@@ -0,0 +1,28 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+namespace SongCore::Utils {
+    /// @brief remembers the calling thread as the game's main thread, called once from late_load
+    void SetMainThread();
+
+    /// @brief whether the calling thread is the main thread, always false before SetMainThread was called
+    bool IsMainThread();
+
+    /// @brief queues the function to run on the main thread, or runs it right away when called from the main thread
+    void RunOnMainThreadDetached(std::function<void()> func);
+
+    /// @brief runs the function on the main thread, directly when already on it
+    /// @return future that becomes ready once the function ran, holding its result or the exception it threw
+    template<typename F>
+    std::future<std::invoke_result_t<F>> RunOnMainThread(F&& func) {
+        using Result = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(func));
+        auto future = task->get_future();
+        RunOnMainThreadDetached([task](){ (*task)(); });
+        return future;
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <span>
+
+#include "SongLoader/CustomBeatmapLevel.hpp"
+
+namespace SongCore::Utils {
+    /// @brief builds a case folded, accent stripped utf8 key from the given text. keys compare correctly with memcmp
+    std::string MakeSortKey(std::u16string_view text);
+
+    /// @brief builds a sort key from multiple texts, joined with a separator that sorts before any printable character
+    std::string MakeSortKey(std::span<StringW const> texts);
+
+    /// @brief builds a big endian key from a float, which compares correctly with memcmp
+    std::string MakeSortKey(float value);
+
+    /// @brief builds a big endian key from a timestamp, which compares newest first with memcmp
+    std::string MakeDateSortKey(int64_t timestamp);
+
+    /// @brief builds the sort key for a level that has no precomputed keys
+    std::string MakeSortKey(GlobalNamespace::BeatmapLevel* level, SongLoader::LevelSortField field);
+
+    /// @brief parses a sort field from its config name
+    std::optional<SongLoader::LevelSortField> LevelSortFieldFromString(std::string_view name);
+
+    /// @brief gets the config name for a sort field
+    std::string_view LevelSortFieldToString(SongLoader::LevelSortField field);
+}
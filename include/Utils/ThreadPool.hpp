@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace SongCore::Utils {
+    /// @brief bounded pool of long lived worker threads that are attached to il2cpp once, so work can use managed objects without paying for a fresh thread and attach every time
+    class ThreadPool {
+        public:
+            /// @brief priority lanes, workers always take from the most important lane that has work
+            enum class Lane : uint8_t {
+                /// @brief work the game or the user is actively waiting on, one worker only ever takes this lane
+                UI,
+                /// @brief song loading and refreshing
+                Loading,
+                /// @brief maintenance that nothing waits on right away, like deleting songs
+                Background,
+                Count
+            };
+
+            /// @brief the pool shared by all of SongCore, its threads are started on first use
+            static ThreadPool& Get();
+
+            /// @param threadCount amount of workers for all lanes, on top of the one reserved for the UI lane
+            explicit ThreadPool(size_t threadCount);
+            ThreadPool(ThreadPool const&) = delete;
+            ThreadPool& operator=(ThreadPool const&) = delete;
+
+            /// @brief queues the work to run on one of the workers
+            void Enqueue(std::function<void()> work, Lane lane = Lane::Background);
+
+            /// @brief queues the function to run on one of the workers
+            /// @return future holding the result of the function or the exception it threw
+            template<typename F>
+            std::future<std::invoke_result_t<F>> Submit(F&& func, Lane lane = Lane::Background) {
+                using Result = std::invoke_result_t<F>;
+                auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(func));
+                auto future = task->get_future();
+                Enqueue([task](){ (*task)(); }, lane);
+                return future;
+            }
+
+            /// @brief waits for a future of work queued on this pool. when called from one of the workers, work that the waiting job queued itself is run while waiting,
+            /// so jobs waiting on their own work can't starve the pool. unrelated work is never picked up, it could be waiting on something further down this stack
+            template<typename Future>
+            void Wait(Future const& future) {
+                if (!IsWorkerThread()) {
+                    future.wait();
+                    return;
+                }
+
+                HelpUntil([&future](){ return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; });
+            }
+
+            size_t get_threadCount() const { return _threadCount; }
+            __declspec(property(get=get_threadCount)) size_t threadCount;
+        private:
+            void StartThreads();
+            void WorkerLoop(bool uiOnly);
+            bool IsWorkerThread() const;
+            /// @brief work in a lane, along with the job that queued it
+            struct QueuedWork {
+                std::function<void()> work;
+                /// @brief id of the job that queued this work, 0 if it was queued from outside the pool
+                uint64_t parent;
+            };
+
+            /// @brief runs work the current job queued on the calling worker until done returns true
+            void HelpUntil(std::function<bool()> done);
+            /// @brief pops the most important queued work, expects the queue to be locked
+            std::function<void()> TryPop(bool uiOnly);
+            /// @brief pops the most important work queued by the given job from any lane, expects the queue to be locked
+            std::function<void()> TryPopChild(uint64_t parent);
+            /// @brief runs the work as a new job and wakes workers that are waiting for work to finish
+            void Run(std::function<void()>& work);
+
+            size_t _threadCount;
+            bool _started = false;
+            size_t _waitingHelpers = 0;
+            std::mutex _queueMutex;
+            std::condition_variable _queueCondition;
+            std::array<std::deque<QueuedWork>, static_cast<size_t>(Lane::Count)> _lanes;
+    };
+}
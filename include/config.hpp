@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <string>
 #include <vector>
 
 struct Config {
@@ -17,6 +18,12 @@ struct Config {
     /// @brief whether to not show the songloader warning again
     bool dontShowSongloaderWarningAgain = false;
 
+    /// @brief field the custom level packs are sorted by, one of songName, songAuthorName, levelAuthorName, beatsPerMinute or dateAdded
+    std::string levelSortField = "songName";
+
+    /// @brief whether to keep every parsed info.dat in memory. when false, only the extracted level details are kept and raw custom data access reparses the file
+    bool keepInfoDocuments = true;
+
     /// @brief multiple paths to folders to load songs from, in case user has multiple folders. Not exposed
     std::vector<std::filesystem::path> RootCustomLevelPaths {
         "/sdcard/ModData/com.beatgames.beatsaber/Mods/SongCore/CustomLevels",
@@ -1,52 +1,81 @@
 #pragma once
 
+#include "System/Action.hpp"
+#include "System/Threading/CancellationToken.hpp"
+#include "System/Threading/CancellationTokenRegistration.hpp"
 #include "System/Threading/Tasks/Task_1.hpp"
 
-#include "beatsaber-hook/shared/threading.hpp"
+#include "custom-types/shared/delegate.hpp"
 
-#include <chrono>
+#include "Utils/ThreadPool.hpp"
+#include "logging.hpp"
+
+#include <exception>
+#include <functional>
+#include <optional>
 
 namespace SongCore {
     template<typename T>
     using Task = System::Threading::Tasks::Task_1<T>;
     using System::Threading::CancellationToken;
+    using System::Threading::CancellationTokenRegistration;
 
-    template<typename Ret, typename T>
-    requires(std::is_invocable_r_v<Ret, T>)
-    static void task_func(Task<Ret>* task, T&& func) {
-        task->TrySetResult(std::invoke(std::forward<T>(func)));
-    }
-
-    template<typename Ret, typename T>
-    requires(std::is_invocable_r_v<Ret, T, CancellationToken>)
-    static void task_cancel_func(Task<Ret>* task, T&& func, CancellationToken&& cancelToken) {
-        using namespace std::chrono_literals;
-        // start func as an std::future
-        auto fut = il2cpp_async(std::forward<T>(func), std::forward<CancellationToken>(cancelToken));
-        // await the future
-        while (fut.wait_for(0ns) != std::future_status::ready && !cancelToken.IsCancellationRequested) std::this_thread::yield();
-
-        // if cancellation wasn't requested, set result, else set canceled
-        if (!cancelToken.IsCancellationRequested) {
-            task->TrySetResult(fut.get());
-        } else {
+    /// @brief completes the task as canceled the moment the token is canceled
+    /// @return the registration to dispose once the task is completed, nullopt if the token can't be canceled
+    template<typename Ret>
+    static std::optional<CancellationTokenRegistration> CancelTaskOnToken(Task<Ret>* task, CancellationToken cancelToken) {
+        if (!cancelToken.CanBeCanceled) return std::nullopt;
+        return cancelToken.Register(custom_types::MakeDelegate<System::Action*>(std::function<void()>([task, cancelToken](){
             task->TrySetCanceled(cancelToken);
-        }
+        })));
     }
 
+    /// @brief runs func on the shared thread pool and completes the task with its result. if func throws, the task is completed as canceled so nothing waits on it forever
     template<typename Ret, typename T>
     requires(!std::is_same_v<Ret, void> && std::is_invocable_r_v<Ret, T>)
     static Task<Ret>* StartTask(T&& func) {
         auto t = Task<Ret>::New_ctor();
-        il2cpp_thread(&task_func<Ret, T>, t, std::forward<T>(func)).detach();
+        Utils::ThreadPool::Get().Enqueue([t, func = std::forward<T>(func)]() mutable {
+            try {
+                t->TrySetResult(std::invoke(func));
+            } catch (std::exception const& e) {
+                ERROR("Caught exception of type {} while running task, the task will be canceled! what: {}", typeid(e).name(), e.what());
+                t->TrySetCanceled(CancellationToken::get_None());
+            } catch (...) {
+                ERROR("Caught exception of unknown type while running task, the task will be canceled!");
+                t->TrySetCanceled(CancellationToken::get_None());
+            }
+        }, Utils::ThreadPool::Lane::UI);
         return t;
     }
 
+    /// @brief runs func on the shared thread pool and completes the task with its result.
+    /// cancelling the token completes the task as canceled right away through a token callback, the work itself is left to notice the token on its own
     template<typename Ret, typename T>
     requires(!std::is_same_v<Ret, void> && std::is_invocable_r_v<Ret, T, CancellationToken>)
     static Task<Ret>* StartTask(T&& func, CancellationToken&& cancelToken) {
         auto t = Task<Ret>::New_ctor();
-        il2cpp_thread(&task_cancel_func<Ret, T>, t, std::forward<T>(func), std::forward<CancellationToken>(cancelToken)).detach();
+        if (cancelToken.IsCancellationRequested) {
+            t->TrySetCanceled(cancelToken);
+            return t;
+        }
+
+        auto registration = CancelTaskOnToken(t, cancelToken);
+
+        Utils::ThreadPool::Get().Enqueue([t, func = std::forward<T>(func), cancelToken, registration]() mutable {
+            try {
+                auto result = std::invoke(func, cancelToken);
+                if (registration) registration->Dispose();
+
+                // the callback may already have completed the task as canceled, in which case the result is dropped
+                if (!cancelToken.IsCancellationRequested) t->TrySetResult(result);
+                else t->TrySetCanceled(cancelToken);
+            } catch (std::exception const& e) {
+                ERROR("Caught exception of type {} while running task, the task will be canceled! what: {}", typeid(e).name(), e.what());
+                if (registration) registration->Dispose();
+                t->TrySetCanceled(cancelToken);
+            }
+        }, Utils::ThreadPool::Lane::UI);
         return t;
     }
 }
@@ -27,6 +27,10 @@ DECLARE_CLASS_CODEGEN_INTERFACES(SongCore, Capabilities, System::Object, Zenject
         /// @return true for registered, false for not
         bool IsCapabilityRegistered(std::string_view capability) const;
 
+        /// @brief checks whether every requirement of the difficulty is registered as a capability
+        /// @return true if the difficulty can be played
+        bool AreRequirementsMet(SongLoader::CustomBeatmapLevel* level, std::string_view characteristic, GlobalNamespace::BeatmapDifficulty difficulty) const;
+
         /// @brief provides access to the registered capabilities without allowing edits
         std::span<const std::string> GetRegisteredCapabilities() const;
         __declspec(property(get=GetRegisteredCapabilities)) std::span<const std::string> RegisteredCapabilities;
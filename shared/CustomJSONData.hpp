@@ -1,8 +1,18 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "custom-types/shared/macros.hpp"
 #include "beatsaber-hook/shared/rapidjson.hpp"
@@ -14,11 +24,193 @@
 #include "UnityEngine/Color.hpp"
 
 #include "_config.h"
+#include "InternedString.hpp"
 
 namespace SongCore::SongLoader { class LevelLoader; }
 namespace SongCore::CustomJSONData {
 	using ValueUTF16 = rapidjson::GenericValue<rapidjson::UTF16<char16_t>>;
 	using DocumentUTF16 = rapidjson::GenericDocument<rapidjson::UTF16<char16_t>>;
+	using ValueUTF8 = rapidjson::GenericValue<rapidjson::UTF8<char>>;
+	using DocumentUTF8 = rapidjson::GenericDocument<rapidjson::UTF8<char>>;
+
+	/// @brief owner of a parsed info.dat. the document can be released once the level details were extracted, after which it gets reparsed from disk on demand
+	class SONGCORE_EXPORT InfoDocument {
+		public:
+			/// @param path path to the info.dat, used to reparse the document after release. empty if it can't be reparsed
+			/// @param document the parsed document
+			InfoDocument(std::filesystem::path path, std::shared_ptr<DocumentUTF8 const> document);
+
+			/// @brief gets the document. if it was released it gets reparsed, going through a small cache of recently reparsed documents
+			/// @return the document, nullptr if it was released and reparsing failed
+			std::shared_ptr<DocumentUTF8 const> Get() const;
+
+			/// @brief gets a utf16 copy of a value in the document. copies are cached while the document is retained, after release every call converts a new copy
+			/// @param pointer json pointer to the value, empty for the document root
+			/// @return converted document, owned by the caller, nullptr if the value doesn't exist
+			std::shared_ptr<DocumentUTF16> GetUTF16(std::string const& pointer) const;
+
+			/// @brief drops the retained document and the cached utf16 copies, does nothing if it can't be reparsed later
+			void Release();
+
+			/// @brief whether the document is kept in memory
+			bool get_isRetained() const;
+			__declspec(property(get=get_isRetained)) bool isRetained;
+
+			std::filesystem::path const& get_path() const { return _path; }
+			__declspec(property(get=get_path)) std::filesystem::path const& path;
+		private:
+			std::filesystem::path _path;
+			mutable std::mutex _mutex;
+			std::shared_ptr<DocumentUTF8 const> _retained;
+			/// @brief utf16 copies by json pointer, only kept while the document is retained
+			mutable std::unordered_map<std::string, std::shared_ptr<DocumentUTF16>> _utf16Copies;
+	};
+
+	/// @brief reference to a value in an info document by json pointer, resolved on access so it survives the document being released.
+	/// also keeps the reference based custom data api working by pinning the value on first access
+	class SONGCORE_EXPORT DocumentValueRef {
+		public:
+			DocumentValueRef() = default;
+			/// @param document the document the value is in
+			/// @param pointer json pointer to the value, empty for the document root
+			DocumentValueRef(std::shared_ptr<InfoDocument const> document, std::string pointer);
+
+			/// @brief gets the value. the pointer keeps the document it is in alive, so it stays valid even if the document was released
+			/// @return the value, nullptr if it doesn't exist
+			std::shared_ptr<const ValueUTF8> Get() const;
+
+			/// @brief gets a utf16 copy of the value as its own document, see InfoDocument::GetUTF16
+			/// @return converted document, nullptr if the value doesn't exist
+			std::shared_ptr<DocumentUTF16> GetUTF16Document() const;
+
+			/// @brief gets a utf16 copy of the value, the pointer keeps the copy alive
+			/// @return converted value, nullptr if the value doesn't exist
+			std::shared_ptr<const ValueUTF16> GetUTF16() const;
+
+			/// @brief gets the value as a reference that stays valid as long as this ref or a copy of it exists.
+			/// the first call keeps the value and its document in memory for that long, prefer Get
+			/// @return the value, nullopt if it doesn't exist
+			std::optional<std::reference_wrapper<const ValueUTF8>> GetPinned() const;
+
+			/// @brief gets a utf16 copy of the value as a reference that stays valid as long as this ref or a copy of it exists, prefer GetUTF16
+			/// @return converted value, nullopt if the value doesn't exist
+			std::optional<std::reference_wrapper<const ValueUTF16>> GetPinnedUTF16() const;
+		private:
+			/// @brief values handed out as references, shared between copies of the ref so they live as long as the object holding it
+			struct Pins {
+				std::mutex mutex;
+				std::shared_ptr<const ValueUTF8> utf8;
+				std::shared_ptr<const ValueUTF16> utf16;
+			};
+
+			std::shared_ptr<InfoDocument const> _document;
+			std::string _pointer;
+			std::shared_ptr<Pins> _pins;
+	};
+
+	/// @brief fixed table with a slot per difficulty, lookups index straight into the slots
+	template<typename T>
+	class DifficultyTable {
+		public:
+			static constexpr size_t DifficultyCount = 5;
+			using Key = GlobalNamespace::BeatmapDifficulty::__BeatmapDifficulty_Unwrapped;
+
+			/// @brief yields pairs of difficulty and entry for the filled slots
+			class const_iterator {
+				public:
+					std::pair<Key, T const&> operator*() const { return { static_cast<Key>(_idx), *(*_slots)[_idx] }; }
+					const_iterator& operator++() { _idx = Next(*_slots, _idx + 1); return *this; }
+					bool operator==(const_iterator const& other) const { return _idx == other._idx; }
+				private:
+					friend class DifficultyTable;
+					const_iterator(std::array<std::optional<T>, DifficultyCount> const* slots, size_t idx) : _slots(slots), _idx(idx) {}
+
+					std::array<std::optional<T>, DifficultyCount> const* _slots;
+					size_t _idx;
+			};
+
+			/// @brief gets the entry for the difficulty, adding an empty one if it isn't there yet
+			T& operator[](GlobalNamespace::BeatmapDifficulty difficulty) {
+				auto& slot = _slots.at(Index(difficulty));
+				if (!slot) slot.emplace();
+				return *slot;
+			}
+
+			/// @brief gets the entry for the difficulty
+			/// @return pointer to the entry, nullptr if the difficulty has no entry
+			T const* Find(GlobalNamespace::BeatmapDifficulty difficulty) const {
+				auto idx = Index(difficulty);
+				if (idx >= DifficultyCount || !_slots[idx]) return nullptr;
+				return &*_slots[idx];
+			}
+
+			bool contains(GlobalNamespace::BeatmapDifficulty difficulty) const { return Find(difficulty) != nullptr; }
+
+			size_t size() const {
+				size_t count = 0;
+				for (auto const& slot : _slots) count += slot.has_value();
+				return count;
+			}
+
+			bool empty() const { return size() == 0; }
+
+			const_iterator begin() const { return const_iterator(&_slots, Next(_slots, 0)); }
+			const_iterator end() const { return const_iterator(&_slots, DifficultyCount); }
+		private:
+			static size_t Index(GlobalNamespace::BeatmapDifficulty difficulty) { return static_cast<size_t>(static_cast<int>(difficulty)); }
+
+			static size_t Next(std::array<std::optional<T>, DifficultyCount> const& slots, size_t idx) {
+				while (idx < DifficultyCount && !slots[idx]) idx++;
+				return idx;
+			}
+
+			std::array<std::optional<T>, DifficultyCount> _slots;
+	};
+
+	/// @brief flat table keyed by interned characteristic name, sorted by the interned id. levels only have a handful of characteristics,
+	/// so this beats a node based map both in lookups and in memory
+	template<typename T>
+	class CharacteristicTable {
+		public:
+			using value_type = std::pair<InternedString, T>;
+			using iterator = typename std::vector<value_type>::iterator;
+			using const_iterator = typename std::vector<value_type>::const_iterator;
+
+			/// @brief gets the entry for the characteristic, adding an empty one if it isn't there yet. adding invalidates references to other entries
+			T& operator[](InternedString name) {
+				auto itr = LowerBound(name);
+				if (itr == _entries.end() || itr->first != name) itr = _entries.emplace(itr, name, T{});
+				return itr->second;
+			}
+
+			const_iterator find(InternedString name) const {
+				auto itr = std::lower_bound(_entries.begin(), _entries.end(), name.id, [](value_type const& entry, uint32_t id) { return entry.first.id < id; });
+				if (itr != _entries.end() && itr->first == name) return itr;
+				return _entries.end();
+			}
+
+			/// @brief gets the entry for the characteristic
+			/// @return pointer to the entry, nullptr if the characteristic has no entry
+			T const* Find(InternedString name) const {
+				auto itr = find(name);
+				return itr != _entries.end() ? &itr->second : nullptr;
+			}
+
+			bool contains(InternedString name) const { return find(name) != _entries.end(); }
+			size_t size() const { return _entries.size(); }
+			bool empty() const { return _entries.empty(); }
+
+			iterator begin() { return _entries.begin(); }
+			iterator end() { return _entries.end(); }
+			const_iterator begin() const { return _entries.begin(); }
+			const_iterator end() const { return _entries.end(); }
+		private:
+			iterator LowerBound(InternedString name) {
+				return std::lower_bound(_entries.begin(), _entries.end(), name.id, [](value_type const& entry, uint32_t id) { return entry.first.id < id; });
+			}
+
+			std::vector<value_type> _entries;
+	};
 
 	/// @brief struct providing custom information about the save data
 	struct CustomSaveDataInfo {
@@ -29,21 +221,94 @@ namespace SongCore::CustomJSONData {
 			V4,
 		} saveDataVersion;
 
-		std::shared_ptr<DocumentUTF16> doc;
-		std::optional<std::reference_wrapper<const ValueUTF16>> customData;
+		/// @brief the info.dat this custom data comes from
+		std::shared_ptr<InfoDocument const> get_document() const { return _document; }
+		__declspec(property(get=get_document)) std::shared_ptr<InfoDocument const> document;
+
+		/// @brief the parsed info.dat, reparsed from disk if it was released
+		SONGCORE_EXPORT std::shared_ptr<DocumentUTF8 const> get_docUTF8() const;
+		__declspec(property(get=get_docUTF8)) std::shared_ptr<DocumentUTF8 const> docUTF8;
+
+		/// @brief the custom data of the info.dat. the reference stays valid as long as this save data, which keeps the document in memory once accessed. prefer sharedCustomDataUTF8
+		SONGCORE_EXPORT std::optional<std::reference_wrapper<const ValueUTF8>> get_customDataUTF8() const;
+		__declspec(property(get=get_customDataUTF8)) std::optional<std::reference_wrapper<const ValueUTF8>> customDataUTF8;
+
+		/// @brief the custom data of the info.dat, the pointer keeps the document alive even if it was released
+		SONGCORE_EXPORT std::shared_ptr<const ValueUTF8> get_sharedCustomDataUTF8() const;
+		__declspec(property(get=get_sharedCustomDataUTF8)) std::shared_ptr<const ValueUTF8> sharedCustomDataUTF8;
+
+		/// @brief utf16 copy of the info.dat, converted on first access. prefer docUTF8
+		SONGCORE_EXPORT std::shared_ptr<DocumentUTF16> get_doc() const;
+		__declspec(property(get=get_doc)) std::shared_ptr<DocumentUTF16> doc;
+
+		/// @brief utf16 copy of the custom data, converted on first access and kept as long as this save data. prefer customDataUTF8
+		SONGCORE_EXPORT std::optional<std::reference_wrapper<const ValueUTF16>> get_customData() const;
+		__declspec(property(get=get_customData)) std::optional<std::reference_wrapper<const ValueUTF16>> customData;
+
+		/// @brief utf16 copy of the custom data, the pointer keeps the copy alive. prefer sharedCustomDataUTF8
+		SONGCORE_EXPORT std::shared_ptr<const ValueUTF16> get_sharedCustomData() const;
+		__declspec(property(get=get_sharedCustomData)) std::shared_ptr<const ValueUTF16> sharedCustomData;
+
+		/// @brief sets the parsed info.dat this custom data comes from
+		/// @param infoPath path of the info.dat, needed to reparse it after ReleaseDocument
+		SONGCORE_EXPORT void SetDocument(std::filesystem::path infoPath, std::shared_ptr<DocumentUTF8 const> document);
+
+		/// @brief extracts the basic level details, then drops the parsed info.dat from memory. raw custom data access reparses the file after this
+		SONGCORE_EXPORT void ReleaseDocument();
 
 		/// @brief struct providing basic information about a difficulty beatmap (characteristic + difficulty)
 		struct BasicCustomDifficultyBeatmapDetails {
+			/// @brief the custom colors of a difficulty, packed into one block with a bit per color that was set
 			struct CustomColors {
-				std::optional<UnityEngine::Color> colorLeft;
-				std::optional<UnityEngine::Color> colorRight;
-				std::optional<UnityEngine::Color> envColorRight;
-				std::optional<UnityEngine::Color> envColorLeft;
-				std::optional<UnityEngine::Color> envColorWhite;
-				std::optional<UnityEngine::Color> envColorLeftBoost;
-				std::optional<UnityEngine::Color> envColorRightBoost;
-				std::optional<UnityEngine::Color> envColorWhiteBoost;
-				std::optional<UnityEngine::Color> obstacleColor;
+				/// @brief index of each color in the block
+				enum Slot : uint8_t {
+					ColorLeft,
+					ColorRight,
+					EnvColorRight,
+					EnvColorLeft,
+					EnvColorWhite,
+					EnvColorLeftBoost,
+					EnvColorRightBoost,
+					EnvColorWhiteBoost,
+					ObstacleColor,
+					SlotCount
+				};
+
+				std::array<UnityEngine::Color, SlotCount> colors{};
+				/// @brief bit per slot, set if the map provides that color
+				uint16_t presentMask = 0;
+
+				bool Has(Slot slot) const { return presentMask & (1 << slot); }
+				/// @brief the color in the slot, or fallback if the map does not provide it
+				UnityEngine::Color Get(Slot slot, UnityEngine::Color fallback) const { return Has(slot) ? colors[slot] : fallback; }
+				void Set(Slot slot, UnityEngine::Color color) { colors[slot] = color; presentMask |= 1 << slot; }
+				/// @brief whether any color was set
+				bool Any() const { return presentMask != 0; }
+
+				std::optional<UnityEngine::Color> GetOptional(Slot slot) const {
+					if (Has(slot)) return colors[slot];
+					return std::nullopt;
+				}
+
+				// optional views of the slots, prefer Get for new code
+				std::optional<UnityEngine::Color> get_colorLeft() const { return GetOptional(ColorLeft); }
+				__declspec(property(get=get_colorLeft)) std::optional<UnityEngine::Color> colorLeft;
+				std::optional<UnityEngine::Color> get_colorRight() const { return GetOptional(ColorRight); }
+				__declspec(property(get=get_colorRight)) std::optional<UnityEngine::Color> colorRight;
+				std::optional<UnityEngine::Color> get_envColorRight() const { return GetOptional(EnvColorRight); }
+				__declspec(property(get=get_envColorRight)) std::optional<UnityEngine::Color> envColorRight;
+				std::optional<UnityEngine::Color> get_envColorLeft() const { return GetOptional(EnvColorLeft); }
+				__declspec(property(get=get_envColorLeft)) std::optional<UnityEngine::Color> envColorLeft;
+				std::optional<UnityEngine::Color> get_envColorWhite() const { return GetOptional(EnvColorWhite); }
+				__declspec(property(get=get_envColorWhite)) std::optional<UnityEngine::Color> envColorWhite;
+				std::optional<UnityEngine::Color> get_envColorLeftBoost() const { return GetOptional(EnvColorLeftBoost); }
+				__declspec(property(get=get_envColorLeftBoost)) std::optional<UnityEngine::Color> envColorLeftBoost;
+				std::optional<UnityEngine::Color> get_envColorRightBoost() const { return GetOptional(EnvColorRightBoost); }
+				__declspec(property(get=get_envColorRightBoost)) std::optional<UnityEngine::Color> envColorRightBoost;
+				std::optional<UnityEngine::Color> get_envColorWhiteBoost() const { return GetOptional(EnvColorWhiteBoost); }
+				__declspec(property(get=get_envColorWhiteBoost)) std::optional<UnityEngine::Color> envColorWhiteBoost;
+				std::optional<UnityEngine::Color> get_obstacleColor() const { return GetOptional(ObstacleColor); }
+				__declspec(property(get=get_obstacleColor)) std::optional<UnityEngine::Color> obstacleColor;
 
 				/// @brief deserializer method
 				/// @return since everything is completely optional, returns true if anything was found, false if nothing was found
@@ -52,25 +317,27 @@ namespace SongCore::CustomJSONData {
 				/// @brief deserializer method
 				/// @return since everything is completely optional, returns true if anything was found, false if nothing was found
 				SONGCORE_EXPORT bool DeserializeV3(ValueUTF16 const& value);
+				SONGCORE_EXPORT bool DeserializeV3(ValueUTF8 const& value);
 
 				/// @brief deserializer method
 				/// @return since everything is completely optional, returns true if anything was found, false if nothing was found
 				SONGCORE_EXPORT bool DeserializeV4(ValueUTF16 const& value);
+				SONGCORE_EXPORT bool DeserializeV4(ValueUTF8 const& value);
 			};
 
 			/// @brief characteristic name as parsed from info.dat
-			std::string characteristicName;
+			InternedString characteristicName;
 			/// @brief difficulty enum as parsed from info.dat
 			GlobalNamespace::BeatmapDifficulty difficulty;
 
 			/// @brief requirements to play this beatmap
-			std::vector<std::string> requirements;
+			std::vector<InternedString> requirements;
 			/// @brief suggestions for this beatmap
-			std::vector<std::string> suggestions;
+			std::vector<InternedString> suggestions;
 			/// @brief warnings for this beatmap
-			std::vector<std::string> warnings;
+			std::vector<InternedString> warnings;
 			/// @brief information for this beatmap
-			std::vector<std::string> information;
+			std::vector<InternedString> information;
 
 			/// @brief if set, the custom diff name
 			std::optional<std::string> customDiffName;
@@ -92,18 +359,20 @@ namespace SongCore::CustomJSONData {
 			/// @brief deserializer method
 			/// @return whether deserialization was succesful
 			SONGCORE_EXPORT bool DeserializeV3(ValueUTF16 const& value);
+			SONGCORE_EXPORT bool DeserializeV3(ValueUTF8 const& value);
 
 			/// @brief deserializer method
 			/// @return whether deserialization was succesful
 			SONGCORE_EXPORT bool DeserializeV4(ValueUTF16 const& value);
+			SONGCORE_EXPORT bool DeserializeV4(ValueUTF8 const& value);
 		};
 
 		/// @brief struct providing basic information about a difficulty beatmap set (characteristic)
 		struct BasicCustomDifficultyBeatmapDetailsSet {
 			/// @brief map of GlobalNamespace::BeatmapDifficulty to BasicCustomDifficultyBeatmapDetails
-			std::unordered_map<GlobalNamespace::BeatmapDifficulty::__BeatmapDifficulty_Unwrapped, BasicCustomDifficultyBeatmapDetails> difficultyToDifficultyBeatmapDetails;
+			DifficultyTable<BasicCustomDifficultyBeatmapDetails> difficultyToDifficultyBeatmapDetails;
 			/// @brief characteristic name as parsed from info.dat
-			std::string characteristicName;
+			InternedString characteristicName;
 			/// @brief optional custom label (hover text)
 			std::optional<std::string> characteristicLabel;
 			/// @brief optional custom icon filename (combine with customLevelPath)
@@ -128,10 +397,12 @@ namespace SongCore::CustomJSONData {
 			/// @brief deserializer method
 			/// @return whether deserialization was succesful
 			SONGCORE_EXPORT bool DeserializeV3(ValueUTF16 const& value);
+			SONGCORE_EXPORT bool DeserializeV3(ValueUTF8 const& value);
 
 			/// @brief deserializer method
 			/// @return whether deserialization was succesful
 			SONGCORE_EXPORT bool DeserializeV4(ValueUTF16 const& value);
+			SONGCORE_EXPORT bool DeserializeV4(ValueUTF8 const& value);
 		};
 
 		/// @brief struct providing basic information about a beatmap
@@ -139,9 +410,9 @@ namespace SongCore::CustomJSONData {
 			/// @brief struct describing a contributor entry
 			struct Contributor {
 				/// @brief name of this contributor
-				std::string name;
+				InternedString name;
 				/// @brief what did they do?
-				std::string role;
+				InternedString role;
 				/// @brief path to the icon to display for this contributor
 				std::filesystem::path iconPath;
 
@@ -152,13 +423,16 @@ namespace SongCore::CustomJSONData {
 				/// @brief deserializer method
 				/// @return whether deserialization was succesful
 				SONGCORE_EXPORT bool DeserializeV3(ValueUTF16 const& value);
+				SONGCORE_EXPORT bool DeserializeV3(ValueUTF8 const& value);
 
 				/// @return whether deserialization was succesful
 				/// @brief deserializer method
 				SONGCORE_EXPORT bool DeserializeV4(ValueUTF16 const& value);
+				SONGCORE_EXPORT bool DeserializeV4(ValueUTF8 const& value);
 			};
 
-			std::unordered_map<std::string, BasicCustomDifficultyBeatmapDetailsSet> characteristicNameToBeatmapDetailsSet;
+			/// @brief map of characteristic name to the details of that characteristic
+			CharacteristicTable<BasicCustomDifficultyBeatmapDetailsSet> characteristicNameToBeatmapDetailsSet;
 
 			/// @brief contributors to this level
 			std::vector<Contributor> contributors;
@@ -192,8 +466,10 @@ namespace SongCore::CustomJSONData {
 			[[deprecated("Use DeserializeV3 instead")]] SONGCORE_EXPORT bool Deserialize(ValueUTF16 const& value);
 
 			SONGCORE_EXPORT bool DeserializeV3(ValueUTF16 const& value);
+			SONGCORE_EXPORT bool DeserializeV3(ValueUTF8 const& value);
 
 			SONGCORE_EXPORT bool DeserializeV4(ValueUTF16 const& value);
+			SONGCORE_EXPORT bool DeserializeV4(ValueUTF8 const& value);
 		};
 
 		/// @brief tries to get the basic level details for this savedata
@@ -229,16 +505,54 @@ namespace SongCore::CustomJSONData {
 		/// @return true if found, false if not
 		[[nodiscard]] SONGCORE_EXPORT bool TryGetCharacteristicAndDifficulty(std::string const& characteristic, GlobalNamespace::BeatmapDifficulty difficulty, BasicCustomDifficultyBeatmapDetails& outDetails);
 
+		/// @brief parses the level details now if that didn't happen yet. the loader does this on its worker threads, so the main thread only reads finished details
+		/// @return whether the details are available
+		SONGCORE_EXPORT bool PrepareLevelDetails();
+
+		/// @brief uses details that were parsed before, for example from the song cache, instead of parsing the document
+		SONGCORE_EXPORT void SetLevelDetails(std::shared_ptr<BasicCustomLevelDetails const> details);
+
+		/// @brief the parsed level details, nullptr if they were not parsed yet
+		std::shared_ptr<BasicCustomLevelDetails const> get_levelDetails() const {
+			if (_levelDetails.state.load(std::memory_order_acquire) != LevelDetailsSlot::Ready) return nullptr;
+			return _levelDetails.details;
+		}
+		__declspec(property(get=get_levelDetails)) std::shared_ptr<BasicCustomLevelDetails const> levelDetails;
+
+		/// @brief how often level details had to be parsed on the main thread. should stay 0, anything else means a level got past the loader without its details
+		SONGCORE_EXPORT static size_t GetMainThreadParseCount();
 	private:
+		/// @brief parses the level details once. concurrent callers wait for the thread that is parsing instead of parsing again
+		/// @return whether the details are available
 		bool ParseLevelDetails();
 
-		/// @brief parses level details assuming the saved json doc is a V3 savedata
-		bool ParseLevelDetailsV3();
+		/// @brief the level details with their parse state. details are only written while the state is Parsing, and never change once Ready
+		struct LevelDetailsSlot {
+			enum State : uint8_t {
+				NotParsed,
+				Parsing,
+				Ready
+			};
 
-		/// @brief parses level details assuming the saved json doc is a V4 savedata
-		bool ParseLevelDetailsV4();
+			LevelDetailsSlot() = default;
+			/// @brief copies finished details, a parse that is still running is not copied
+			LevelDetailsSlot(LevelDetailsSlot const& other) { *this = other; }
+			LevelDetailsSlot& operator=(LevelDetailsSlot const& other) {
+				if (this == &other) return *this;
+				bool ready = other.state.load(std::memory_order_acquire) == Ready;
+				details = ready ? other.details : nullptr;
+				state.store(ready ? Ready : NotParsed, std::memory_order_release);
+				return *this;
+			}
+
+			std::atomic<uint8_t> state = NotParsed;
+			std::shared_ptr<BasicCustomLevelDetails const> details;
+		};
 
-		std::optional<BasicCustomLevelDetails> _cachedLevelDetails;
+		LevelDetailsSlot _levelDetails;
+		std::shared_ptr<InfoDocument> _document;
+		DocumentValueRef _docUTF16;
+		DocumentValueRef _customData;
 	};
 }
 
@@ -283,8 +597,26 @@ DECLARE_CLASS_CODEGEN(SongCore::CustomJSONData, CustomDifficultyBeatmapSet, Glob
 			StringW beatmapCharacteristicName,
 			ArrayW<GlobalNamespace::StandardLevelInfoSaveData::DifficultyBeatmap*> difficultyBeatmaps
 		);
+	DECLARE_SIMPLE_DTOR();
 	public:
-		std::optional<std::reference_wrapper<const ValueUTF16>> customData;
+		/// @brief the custom data, resolved from the info document
+		std::optional<std::reference_wrapper<const ValueUTF8>> get_customDataUTF8() const { return _customData.GetPinned(); }
+		__declspec(property(get=get_customDataUTF8)) std::optional<std::reference_wrapper<const ValueUTF8>> customDataUTF8;
+
+		/// @brief the custom data, the pointer keeps its document alive
+		std::shared_ptr<const ValueUTF8> get_sharedCustomDataUTF8() const { return _customData.Get(); }
+		__declspec(property(get=get_sharedCustomDataUTF8)) std::shared_ptr<const ValueUTF8> sharedCustomDataUTF8;
+
+		/// @brief utf16 copy of the custom data, converted on first access. prefer customDataUTF8
+		std::optional<std::reference_wrapper<const ValueUTF16>> get_customData() const { return _customData.GetPinnedUTF16(); }
+		__declspec(property(get=get_customData)) std::optional<std::reference_wrapper<const ValueUTF16>> customData;
+
+		/// @brief utf16 copy of the custom data, the pointer keeps the copy alive. prefer sharedCustomDataUTF8
+		std::shared_ptr<const ValueUTF16> get_sharedCustomData() const { return _customData.GetUTF16(); }
+		__declspec(property(get=get_sharedCustomData)) std::shared_ptr<const ValueUTF16> sharedCustomData;
+	private:
+		friend class ::SongCore::SongLoader::LevelLoader;
+		DocumentValueRef _customData;
 };
 
 DECLARE_CLASS_CODEGEN(SongCore::CustomJSONData, CustomDifficultyBeatmap, GlobalNamespace::StandardLevelInfoSaveData::DifficultyBeatmap) {
@@ -299,8 +631,26 @@ DECLARE_CLASS_CODEGEN(SongCore::CustomJSONData, CustomDifficultyBeatmap, GlobalN
 		int environmentNameIdx
 	);
 
+	DECLARE_SIMPLE_DTOR();
 	public:
-		std::optional<std::reference_wrapper<const ValueUTF16>> customData;
+		/// @brief the custom data, resolved from the info document
+		std::optional<std::reference_wrapper<const ValueUTF8>> get_customDataUTF8() const { return _customData.GetPinned(); }
+		__declspec(property(get=get_customDataUTF8)) std::optional<std::reference_wrapper<const ValueUTF8>> customDataUTF8;
+
+		/// @brief the custom data, the pointer keeps its document alive
+		std::shared_ptr<const ValueUTF8> get_sharedCustomDataUTF8() const { return _customData.Get(); }
+		__declspec(property(get=get_sharedCustomDataUTF8)) std::shared_ptr<const ValueUTF8> sharedCustomDataUTF8;
+
+		/// @brief utf16 copy of the custom data, converted on first access. prefer customDataUTF8
+		std::optional<std::reference_wrapper<const ValueUTF16>> get_customData() const { return _customData.GetPinnedUTF16(); }
+		__declspec(property(get=get_customData)) std::optional<std::reference_wrapper<const ValueUTF16>> customData;
+
+		/// @brief utf16 copy of the custom data, the pointer keeps the copy alive. prefer sharedCustomDataUTF8
+		std::shared_ptr<const ValueUTF16> get_sharedCustomData() const { return _customData.GetUTF16(); }
+		__declspec(property(get=get_sharedCustomData)) std::shared_ptr<const ValueUTF16> sharedCustomData;
+	private:
+		friend class ::SongCore::SongLoader::LevelLoader;
+		DocumentValueRef _customData;
 };
 
 // V4
@@ -336,6 +686,24 @@ DECLARE_CLASS_CODEGEN(SongCore::CustomJSONData, CustomDifficultyBeatmapV4, Beatm
 		float noteJumpStartBeatOffset
 	);
 
+	DECLARE_SIMPLE_DTOR();
 public:
-	std::optional<std::reference_wrapper<const ValueUTF16>> customData;
+	/// @brief the custom data, resolved from the info document
+	std::optional<std::reference_wrapper<const ValueUTF8>> get_customDataUTF8() const { return _customData.GetPinned(); }
+	__declspec(property(get=get_customDataUTF8)) std::optional<std::reference_wrapper<const ValueUTF8>> customDataUTF8;
+
+	/// @brief the custom data, the pointer keeps its document alive
+	std::shared_ptr<const ValueUTF8> get_sharedCustomDataUTF8() const { return _customData.Get(); }
+	__declspec(property(get=get_sharedCustomDataUTF8)) std::shared_ptr<const ValueUTF8> sharedCustomDataUTF8;
+
+	/// @brief utf16 copy of the custom data, converted on first access. prefer customDataUTF8
+	std::optional<std::reference_wrapper<const ValueUTF16>> get_customData() const { return _customData.GetPinnedUTF16(); }
+	__declspec(property(get=get_customData)) std::optional<std::reference_wrapper<const ValueUTF16>> customData;
+
+	/// @brief utf16 copy of the custom data, the pointer keeps the copy alive. prefer sharedCustomDataUTF8
+	std::shared_ptr<const ValueUTF16> get_sharedCustomData() const { return _customData.GetUTF16(); }
+	__declspec(property(get=get_sharedCustomData)) std::shared_ptr<const ValueUTF16> sharedCustomData;
+private:
+	friend class ::SongCore::SongLoader::LevelLoader;
+	DocumentValueRef _customData;
 };
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "_config.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace SongCore {
+    /// @brief handle to a string in the global interned string pool. equal strings share one copy and compare by id.
+    /// interned strings are never freed, so only use this for strings that repeat a lot (requirements, characteristic names, contributors...)
+    class SONGCORE_EXPORT InternedString {
+        public:
+            /// @brief the empty string
+            InternedString() = default;
+
+            /// @brief interns the string, adding it to the pool if it was not seen before. explicit, since the pool never frees anything
+            explicit InternedString(std::string_view str);
+            explicit InternedString(std::string const& str) : InternedString(std::string_view(str)) {}
+            explicit InternedString(char const* str) : InternedString(std::string_view(str)) {}
+
+            /// @brief finds an already interned string without adding it to the pool
+            /// @return the interned string, or nullopt if str was never interned
+            static std::optional<InternedString> Find(std::string_view str);
+
+            /// @brief amount of distinct strings in the pool
+            static size_t GetPoolCount();
+
+            /// @brief amount of bytes the pool has allocated for string data
+            static size_t GetPoolBytes();
+
+            /// @brief the id of this string in the pool, 0 is the empty string
+            uint32_t get_id() const { return _id; }
+            __declspec(property(get=get_id)) uint32_t id;
+
+            /// @brief view of the interned string, valid for the lifetime of the game
+            std::string_view view() const;
+            std::string str() const { return std::string(view()); }
+            char const* c_str() const { return view().data(); }
+            size_t size() const { return view().size(); }
+            bool empty() const { return _id == 0; }
+
+            operator std::string_view() const { return view(); }
+
+            bool operator==(InternedString const& other) const { return _id == other._id; }
+            /// @brief compares the contents, without interning the other string
+            bool operator==(std::string_view other) const { return view() == other; }
+            bool operator==(std::string const& other) const { return view() == other; }
+            bool operator==(char const* other) const { return view() == other; }
+        private:
+            explicit InternedString(uint32_t id) : _id(id) {}
+
+            uint32_t _id = 0;
+    };
+}
+
+template<>
+struct std::hash<SongCore::InternedString> {
+    size_t operator()(SongCore::InternedString const& str) const noexcept { return std::hash<uint32_t>()(str.id); }
+};
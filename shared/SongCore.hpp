@@ -9,6 +9,8 @@
 
 #include "SongLoader/CustomLevelPack.hpp"
 #include "SongLoader/CustomBeatmapLevel.hpp"
+#include "SongLoader/DifficultyMask.hpp"
+#include "SongLoader/RequirementMask.hpp"
 
 #include "CustomJSONData.hpp"
 
@@ -42,11 +44,32 @@ namespace SongCore::API {
         /// @return true for registered, false for not
         SONGCORE_EXPORT bool IsCapabilityRegistered(std::string_view capability);
 
-        /// @brief provides access to the registered capabilities without allowing edits
+        /// @brief provides access to the registered capabilities without allowing edits. this is a snapshot, it stays valid but does not see later changes
         SONGCORE_EXPORT std::span<const std::string> GetRegisteredCapabilities();
 
         /// @brief provides access to an event that gets invoked when the capabilities are updated. not guaranteed to run on main thread! not cleared on soft restart. Invoked after the particular capability is added to the list.
         SONGCORE_EXPORT unordered_event_callback<std::string_view, Capabilities::CapabilityEventKind>& GetCapabilitiesUpdatedEvent();
+
+        /// @brief gets the registered capabilities as a mask, which can be tested against the requirement masks of levels
+        SONGCORE_EXPORT ::SongCore::SongLoader::RequirementMask GetRegisteredCapabilityMask();
+
+        /// @brief checks whether every requirement of the difficulty is registered as a capability
+        /// @param level the level to check
+        /// @param characteristic the characteristic serialized name
+        /// @param difficulty the difficulty to check
+        /// @return true if the difficulty can be played
+        SONGCORE_EXPORT bool AreRequirementsMet(::SongCore::SongLoader::CustomBeatmapLevel* level, std::string_view characteristic, GlobalNamespace::BeatmapDifficulty difficulty);
+
+        /// @brief checks whether any difficulty of the level can be played with the registered capabilities
+        SONGCORE_EXPORT bool IsLevelPlayable(::SongCore::SongLoader::CustomBeatmapLevel* level);
+
+        /// @brief gets all loaded levels that have at least one difficulty playable with the registered capabilities
+        /// @return playable levels, empty if songloader not setup
+        SONGCORE_EXPORT std::vector<::SongCore::SongLoader::CustomBeatmapLevel*> GetPlayableLevels();
+
+        /// @brief gets the loaded levels that are not playable right now, but would become playable if the capability gets registered
+        /// @return levels, empty if songloader not setup
+        SONGCORE_EXPORT std::vector<::SongCore::SongLoader::CustomBeatmapLevel*> GetLevelsUnlockedByCapability(std::string_view capability);
     }
 
     namespace PlayButton {
@@ -158,6 +181,18 @@ namespace SongCore::API {
         /// @return future you can use to check whether songs are done refreshing. if you want an onFinished see `GetSongsLoadedEvent`
         SONGCORE_EXPORT std::shared_future<void> RefreshSongs(bool fullRefresh = false);
 
+        /// @brief reload only the levels at the given paths, if the songloader doesn't exist an invalid future is returned
+        /// @return future you can use to check whether the levels are done refreshing
+        SONGCORE_EXPORT std::shared_future<void> RefreshLevels(std::span<std::filesystem::path const> levelPaths);
+
+        /// @brief load a single level, or reload it if it was already loaded, without a full refresh. if the songloader doesn't exist an invalid future is returned
+        /// @return future you can use to check whether the level is done loading. if you want the level see `GetLevelAddedEvent`
+        SONGCORE_EXPORT std::shared_future<void> LoadLevel(std::filesystem::path const& levelPath);
+
+        /// @brief unload a single level without deleting it from disk, if the songloader doesn't exist an invalid future is returned
+        /// @return future you can use to check whether the level is done unloading
+        SONGCORE_EXPORT std::shared_future<void> UnloadLevel(std::filesystem::path const& levelPath);
+
         /// @brief refresh the level packs, since this does not take long, it is not async
         SONGCORE_EXPORT void RefreshLevelPacks();
 
@@ -165,6 +200,12 @@ namespace SongCore::API {
         /// @return a future you can use to check whether the deletion is done. if the songloader didn't exist yet it will give you a future that's not valid
         SONGCORE_EXPORT std::future<void> DeleteSong(std::filesystem::path const& levelPath);
 
+        /// @brief gets the field the custom level packs are sorted by
+        SONGCORE_EXPORT SongLoader::LevelSortField GetLevelSortField();
+
+        /// @brief sets the field the custom level packs are sorted by and saves it to the config. if songs are loaded the packs are resorted right away, so call this on main thread
+        SONGCORE_EXPORT void SetLevelSortField(SongLoader::LevelSortField field);
+
         /// @brief delete a song by providing its preview beatmap level
         /// @return a future you can use to check whether the deletion is done. if the songloader didn't exist yet it will give you a future that's not valid
         SONGCORE_EXPORT std::future<void> DeleteSong(::SongCore::SongLoader::CustomBeatmapLevel* beatmapLevel);
@@ -187,6 +228,12 @@ namespace SongCore::API {
         /// @brief event ran after a song was deleted. At this point there's no way of knowing what song it was so it's advised to look at `GetSongWillBeDeletedEvent`
         SONGCORE_EXPORT unordered_event_callback<>& GetSongDeletedEvent();
 
+        /// @brief event ran after a single level was loaded by a targeted load, ran on main thread. full refreshes only invoke `GetSongsLoadedEvent`
+        SONGCORE_EXPORT unordered_event_callback<::SongCore::SongLoader::CustomBeatmapLevel*>& GetLevelAddedEvent();
+
+        /// @brief event ran after a single level was unloaded by a targeted unload or a deletion, ran on main thread. the level is no longer in any collection at this point
+        SONGCORE_EXPORT unordered_event_callback<::SongCore::SongLoader::CustomBeatmapLevel*>& GetLevelRemovedEvent();
+
         /// @brief returns the path where levels should be stored
         SONGCORE_EXPORT std::filesystem::path GetPreferredCustomLevelPath();
 
@@ -199,12 +246,12 @@ namespace SongCore::API {
         /// @brief returns a span of the custom WIP level paths songloader loads levels from
         SONGCORE_EXPORT std::span<std::filesystem::path const> GetRootCustomWIPLevelPaths();
 
-        /// @brief adds a path to the songcore config to load songs from
+        /// @brief adds a path to the songcore config to load songs from, and loads the levels in it without reloading the other paths
         /// @param path the path to load from
         /// @param wipPath whether this path is a wip path
         SONGCORE_EXPORT void AddLevelPath(std::filesystem::path const& path, bool wipPath = false);
 
-        /// @brief removes a path from the songcore config
+        /// @brief removes a path from the songcore config, and unloads the levels that were loaded from it
         /// @param path the path to remove
         /// @param wipPath whether this path is a wipPath
         SONGCORE_EXPORT void RemoveLevelPath(std::filesystem::path const& path, bool wipPath = false);
@@ -249,6 +296,16 @@ namespace SongCore::API {
         /// @brief gets a level by a search function
         /// @return nullptr if level not found
         SONGCORE_EXPORT ::SongCore::SongLoader::CustomBeatmapLevel* GetLevelByFunction(std::function<bool(::SongCore::SongLoader::CustomBeatmapLevel*)> searchFunction);
+
+        /// @brief gets the levels that match every clause, where a clause matches if the level has any of the characteristic/difficulty bits in it.
+        /// e.g. {DifficultyMask().With("360Degree", ExpertPlus), DifficultyMask().With("Lawless")} gives levels with a 360 Expert+ and any Lawless difficulty.
+        /// build clauses with With, Set would assign slots to characteristics no level has
+        /// @return matching levels, empty if songloader not setup
+        SONGCORE_EXPORT std::vector<::SongCore::SongLoader::CustomBeatmapLevel*> GetLevelsMatching(std::span<::SongCore::SongLoader::DifficultyMask const> clauses);
+
+        /// @brief counts the levels that match every clause, see GetLevelsMatching
+        /// @return amount of matching levels, 0 if songloader not setup
+        SONGCORE_EXPORT size_t CountLevelsMatching(std::span<::SongCore::SongLoader::DifficultyMask const> clauses);
     }
 
     namespace LevelSelect {
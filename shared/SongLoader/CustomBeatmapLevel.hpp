@@ -5,6 +5,30 @@
 #include "GlobalNamespace/IBeatmapLevelData.hpp"
 #include "GlobalNamespace/BeatmapCharacteristicSO.hpp"
 #include "../CustomJSONData.hpp"
+#include "DifficultyMask.hpp"
+#include "RequirementMask.hpp"
+
+#include <array>
+
+namespace SongCore::SongLoader {
+    class LevelLoader;
+
+    /// @brief the field custom level packs are sorted by
+    enum class LevelSortField : uint8_t {
+        SongName = 0,
+        SongAuthorName = 1,
+        LevelAuthorName = 2,
+        BeatsPerMinute = 3,
+        /// @brief sorts newest levels first
+        DateAdded = 4
+    };
+
+    /// @brief requirements of a single difficulty, identified by its DifficultyMask bit
+    struct DifficultyRequirements {
+        uint16_t difficultyBit;
+        RequirementMask requirements;
+    };
+}
 
 // type which is basically a beatmaplevel but one made by songcore, helps with identification
 DECLARE_CLASS_CODEGEN(SongCore::SongLoader, CustomBeatmapLevel, GlobalNamespace::BeatmapLevel) {
@@ -47,6 +71,27 @@ DECLARE_CLASS_CODEGEN(SongCore::SongLoader, CustomBeatmapLevel, GlobalNamespace:
         GlobalNamespace::IBeatmapLevelData* get_beatmapLevelData() const { return _beatmapLevelData; }
         __declspec(property(get=get_beatmapLevelData)) GlobalNamespace::IBeatmapLevelData* beatmapLevelData;
 
+        /// @brief characteristic x difficulty bitset of the difficulties this level has, built during load
+        DifficultyMask const& get_difficultyMask() const { return _difficultyMask; }
+        __declspec(property(get=get_difficultyMask)) DifficultyMask const& difficultyMask;
+
+        /// @brief requirements for every loaded difficulty that has any, sorted by difficulty bit. built during load
+        std::span<DifficultyRequirements const> get_difficultyRequirements() const { return _difficultyRequirements; }
+        __declspec(property(get=get_difficultyRequirements)) std::span<DifficultyRequirements const> difficultyRequirements;
+
+        /// @brief gets the requirements for a characteristic and difficulty
+        /// @return requirements, or nullptr if the difficulty has none
+        RequirementMask const* GetRequirements(std::string_view characteristic, GlobalNamespace::BeatmapDifficulty difficulty) const;
+
+        /// @brief checks whether the difficulty can be played with the given capabilities. requirements that didn't get an id are checked against the registered capabilities by string
+        bool IsPlayable(std::string_view characteristic, GlobalNamespace::BeatmapDifficulty difficulty, RequirementMask const& capabilities) const;
+
+        /// @brief checks whether any loaded difficulty can be played with the given capabilities, see the per difficulty IsPlayable
+        bool IsPlayable(RequirementMask const& capabilities) const;
+
+        /// @brief precomputed binary sort key for the given field, compare keys with memcmp (or string_view::compare) to get the sort order
+        std::string_view GetSortKey(LevelSortField field) const { return _sortKeys[static_cast<size_t>(field)]; }
+
         static CustomBeatmapLevel* New(
             std::string_view customLevelPath,
             CustomJSONData::CustomLevelInfoSaveDataV2* saveDataV2,
@@ -71,8 +116,17 @@ DECLARE_CLASS_CODEGEN(SongCore::SongLoader, CustomBeatmapLevel, GlobalNamespace:
             ::System::Collections::Generic::Dictionary_2<::System::ValueTuple_2<GlobalNamespace::BeatmapCharacteristic, ::GlobalNamespace::BeatmapDifficulty>, ::GlobalNamespace::BeatmapBasicData*>* beatmapBasicData
         );
     private:
+        friend class LevelLoader;
+
+        /// @brief checks the requirement strings of a difficulty whose requirements overflowed
+        bool AreRequirementStringsMet(std::string_view characteristic, GlobalNamespace::BeatmapDifficulty difficulty, RequirementMask const& capabilities) const;
+
         CustomJSONData::CustomLevelInfoSaveDataV2* _customLevelSaveDataV2;
         CustomJSONData::CustomBeatmapLevelSaveDataV4* _customBeatmapLevelSaveDataV4;
         GlobalNamespace::IBeatmapLevelData* _beatmapLevelData;
         std::string _customLevelPath;
+        /// @brief sort keys indexed by LevelSortField, built once when the level is created
+        std::array<std::string, 5> _sortKeys;
+        DifficultyMask _difficultyMask;
+        std::vector<DifficultyRequirements> _difficultyRequirements;
 };
\ No newline at end of file
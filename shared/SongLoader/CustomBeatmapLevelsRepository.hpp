@@ -5,20 +5,40 @@
 #include "GlobalNamespace/BeatmapLevelsRepository.hpp"
 #include "CustomLevelPack.hpp"
 #include <span>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 DECLARE_CLASS_CODEGEN(SongCore::SongLoader, CustomBeatmapLevelsRepository, GlobalNamespace::BeatmapLevelsRepository) {
     DECLARE_CTOR(ctor);
         DECLARE_INSTANCE_FIELD_PRIVATE(ListW<GlobalNamespace::BeatmapLevelPack*>, _levelPacks);
     public:
-        /// @brief adds a level pack to the level packs list
+        /// @brief adds a level pack to the level packs list and adds its levels to the backing dictionaries
         void AddLevelPack(GlobalNamespace::BeatmapLevelPack* pack);
-        /// @brief removes a level pack from the level packs list
+        /// @brief removes a level pack from the level packs list and removes its levels from the backing dictionaries
         void RemoveLevelPack(GlobalNamespace::BeatmapLevelPack* pack);
+        /// @brief whether a pack with the same id as the given pack was added
+        bool HasLevelPack(GlobalNamespace::BeatmapLevelPack* pack);
         /// @brief completely clears the level packs list
         void ClearLevelPacks();
-        /// @brief takes the level packs list and fixes all the backing dictionaries. This is a somewhat expensive operation as it involves a lot of inserts into dicts
+        /// @brief adds the levels of an added pack to the backing dictionaries. level objects already added for the pack are skipped
+        void AddLevels(GlobalNamespace::BeatmapLevelPack* pack, std::span<GlobalNamespace::BeatmapLevel* const> levels);
+        /// @brief removes the levels of an added pack from the backing dictionaries. ids another level in the pack or another pack also holds stay, pointing at that level
+        void RemoveLevels(GlobalNamespace::BeatmapLevelPack* pack, std::span<GlobalNamespace::BeatmapLevel* const> levels);
+        /// @brief brings the backing dictionaries up to date with the current levels of an added pack, only touching the level objects that changed since they were added
+        void UpdateLevelPack(GlobalNamespace::BeatmapLevelPack* pack);
+        /// @brief takes the level packs list and rebuilds all the backing dictionaries. This is a somewhat expensive operation as it involves a lot of inserts into dicts,
+        /// only needed when packs were changed without going through this repository
         void FixBackingDictionaries();
 
         std::span<GlobalNamespace::BeatmapLevelPack* const> GetBeatmapLevelPacks() const { return _levelPacks; }
         __declspec(property(get=GetBeatmapLevelPacks)) std::span<GlobalNamespace::BeatmapLevelPack* const> BeatmapLevelPacks;
+    private:
+        /// @brief removes a level id that was taken out of the pack from the backing dictionaries, or points it at another pack that holds it and at that pack's level.
+        /// removedLevel is the level object taken out, if known, which is never kept as the level for the id
+        void RemoveLevelID(GlobalNamespace::BeatmapLevelPack* pack, std::u16string const& levelID, GlobalNamespace::BeatmapLevel* removedLevel);
+
+        /// @brief per added pack the level objects it holds by level id, usually one per id. the first one is what the backing dictionaries point at for the pack
+        std::unordered_map<GlobalNamespace::BeatmapLevelPack*, std::unordered_map<std::u16string, std::vector<GlobalNamespace::BeatmapLevel*>>> _indexedLevels;
 };
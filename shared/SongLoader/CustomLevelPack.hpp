@@ -4,7 +4,9 @@
 #include "GlobalNamespace/BeatmapLevelPack.hpp"
 #include "GlobalNamespace/BeatmapLevel.hpp"
 #include "CustomBeatmapLevel.hpp"
+#include <optional>
 #include <string>
+#include <vector>
 
 DECLARE_CLASS_CODEGEN(SongCore::SongLoader, CustomLevelPack, GlobalNamespace::BeatmapLevelPack) {
     DECLARE_CTOR(ctor, StringW packId, StringW packName, UnityEngine::Sprite* coverImage);
@@ -12,9 +14,12 @@ DECLARE_CLASS_CODEGEN(SongCore::SongLoader, CustomLevelPack, GlobalNamespace::Be
     public:
         static CustomLevelPack* New(std::string_view packId, std::string_view packName, UnityEngine::Sprite* coverImage = nullptr);
 
-        /// @brief sorts the levels in the collection, based on `a->songName < b->songName`
+        /// @brief sorts the levels in the collection by song name, using case and accent insensitive sort keys
         void SortLevels();
 
+        /// @brief sorts the levels in the collection by the given field, using the precomputed sort keys of the levels. std::stable_sort is used
+        void SortLevels(LevelSortField field);
+
         /// @brief sorting function that returns `a < b`
         using WeakSortingFunc = std::function<bool(GlobalNamespace::BeatmapLevel*, GlobalNamespace::BeatmapLevel*)>;
 
@@ -26,4 +31,20 @@ DECLARE_CLASS_CODEGEN(SongCore::SongLoader, CustomLevelPack, GlobalNamespace::Be
 
         /// @brief sets the levels in the collection based on the inputted span
         void SetLevels(std::span<CustomBeatmapLevel* const> levels);
+
+        /// @brief sets the levels in the collection sorted by the given field, the managed array is only written once
+        void SetLevels(std::span<CustomBeatmapLevel* const> levels, LevelSortField field);
+
+        /// @brief inserts the levels at their sorted place for the field, without resorting the rest. if the collection isn't sorted by the field, all levels get sorted by it
+        void AddLevels(std::span<CustomBeatmapLevel* const> levels, LevelSortField field);
+
+        /// @brief removes the levels from the collection
+        /// @return the levels that were in the collection and got removed
+        std::vector<GlobalNamespace::BeatmapLevel*> RemoveLevels(std::span<CustomBeatmapLevel* const> levels);
+    private:
+        /// @brief rebuilds _allBeatmapLevels from copies of _beatmapLevels and _additionalBeatmapLevels
+        void UpdateAllBeatmapLevels();
+
+        /// @brief the field the levels were last sorted by through this pack, nullopt if they were set unsorted or sorted with a custom function
+        std::optional<LevelSortField> _sortedBy;
 };
\ No newline at end of file
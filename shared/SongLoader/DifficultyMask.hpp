@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../_config.h"
+
+#include "GlobalNamespace/BeatmapDifficulty.hpp"
+
+#include <bitset>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace SongCore::SongLoader {
+    /// @brief compact characteristic x difficulty bitset, one bit per difficulty for every characteristic songcore has seen
+    struct SONGCORE_EXPORT DifficultyMask {
+        /// @brief max amount of distinct characteristics the mask can track, characteristics seen after this are ignored
+        static constexpr size_t MaxCharacteristics = 64;
+        /// @brief amount of difficulties per characteristic, Easy through ExpertPlus
+        static constexpr size_t DifficultyCount = 5;
+        static constexpr size_t BitCount = MaxCharacteristics * DifficultyCount;
+
+        std::bitset<BitCount> bits;
+
+        /// @brief gets the slot for a characteristic serialized name, assigning a new one if this characteristic was not seen before
+        /// @return slot index, or nullopt if all slots are taken
+        static std::optional<size_t> GetCharacteristicSlot(std::string_view serializedName);
+
+        /// @brief finds the slot for a characteristic serialized name without assigning one, for lookups that should not use up slots
+        /// @return slot index, or nullopt if this characteristic was not seen before
+        static std::optional<size_t> FindCharacteristicSlot(std::string_view serializedName);
+
+        /// @brief gets the bit index for a characteristic and difficulty, never assigns a slot
+        /// @return bit index, or nullopt if the characteristic has no slot or the difficulty is out of range
+        static std::optional<size_t> GetBit(std::string_view serializedName, GlobalNamespace::BeatmapDifficulty difficulty);
+
+        /// @brief gets the characteristic serialized name that was assigned to the slot
+        static std::optional<std::string> GetCharacteristicForSlot(size_t slot);
+
+        /// @brief sets the bit for the characteristic and difficulty, assigning the characteristic a slot if it has none
+        DifficultyMask& Set(std::string_view serializedName, GlobalNamespace::BeatmapDifficulty difficulty);
+
+        /// @brief sets the bits for every difficulty of the characteristic
+        DifficultyMask& Set(std::string_view serializedName);
+
+        /// @brief sets the bit for the characteristic and difficulty if the characteristic has a slot, never assigns one. use this to build queries,
+        /// a characteristic no level has is left out and the clause it is in matches nothing
+        DifficultyMask& With(std::string_view serializedName, GlobalNamespace::BeatmapDifficulty difficulty);
+
+        /// @brief sets the bits for every difficulty of the characteristic if it has a slot, never assigns one. see With
+        DifficultyMask& With(std::string_view serializedName);
+
+        /// @brief checks whether the bit for the characteristic and difficulty is set
+        bool Has(std::string_view serializedName, GlobalNamespace::BeatmapDifficulty difficulty) const;
+
+        /// @brief checks whether any difficulty of the characteristic is set
+        bool Has(std::string_view serializedName) const;
+
+        /// @brief whether any bit is shared with the other mask
+        bool Intersects(DifficultyMask const& other) const { return (bits & other.bits).any(); }
+
+        /// @brief whether every bit of the other mask is also set in this mask
+        bool Contains(DifficultyMask const& other) const { return (bits & other.bits) == other.bits; }
+
+        bool operator==(DifficultyMask const& other) const = default;
+    };
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "../_config.h"
+#include "DifficultyMask.hpp"
+#include "RequirementMask.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace SongCore::SongLoader {
+    class CustomBeatmapLevel;
+
+    /// @brief inverted index from every characteristic x difficulty bit to the levels that have it, stored as one bitmap over the levels per bit
+    class SONGCORE_EXPORT LevelIndex {
+        public:
+            /// @brief bitmap over the indexed levels, bit i is level i
+            using Bitmap = std::vector<uint64_t>;
+
+            /// @brief rebuilds the index for the given levels
+            void Build(std::span<CustomBeatmapLevel* const> levels);
+
+            /// @brief adds a single level to the index
+            void Add(CustomBeatmapLevel* level);
+
+            /// @brief removes a single level from the index, the last level takes its place
+            /// @return whether the level was in the index
+            bool Remove(CustomBeatmapLevel* level);
+
+            /// @brief finds the levels which match every clause, where a clause matches if the level has any of the bits in the clause
+            /// @param clauses the clauses to match, an empty span matches every level
+            /// @return bitmap of matching levels
+            Bitmap Match(std::span<DifficultyMask const> clauses) const;
+
+            /// @brief counts the levels which match every clause, see Match
+            size_t Count(std::span<DifficultyMask const> clauses) const;
+
+            /// @brief gets the levels which match every clause, see Match
+            std::vector<CustomBeatmapLevel*> Query(std::span<DifficultyMask const> clauses) const;
+
+            /// @brief finds the levels that have at least one difficulty with the requirement
+            Bitmap MatchRequirement(std::string_view requirement) const;
+
+            /// @brief gets the levels that have at least one difficulty with the requirement
+            std::vector<CustomBeatmapLevel*> GetLevelsRequiring(std::string_view requirement) const;
+
+            /// @brief finds the levels that have at least one difficulty playable with the given capabilities
+            Bitmap MatchPlayable(RequirementMask const& capabilities) const;
+
+            /// @brief gets the levels that are not playable with the given capabilities, but would be once the capability is added
+            std::vector<CustomBeatmapLevel*> GetLevelsUnlockedBy(std::string_view capability, RequirementMask const& capabilities) const;
+
+            /// @brief gets the levels that are set in the bitmap
+            std::vector<CustomBeatmapLevel*> GetLevels(Bitmap const& bitmap) const;
+
+            /// @brief the levels this index was built for
+            std::span<CustomBeatmapLevel* const> get_Levels() const { return _levels; }
+            __declspec(property(get=get_Levels)) std::span<CustomBeatmapLevel* const> Levels;
+        private:
+            /// @brief ors the bitmaps of every bit set in the mask into out
+            void OrBitmaps(DifficultyMask const& mask, Bitmap& out) const;
+
+            /// @brief sets the bits for the level at the index in every bitmap it belongs to
+            void SetBits(size_t levelIdx);
+
+            /// @brief resizes every allocated bitmap to the word count
+            void ResizeBitmaps(size_t wordCount);
+
+            /// @brief runs func for every allocated bitmap and the requirements bitmap
+            template<typename F>
+            void ForEachBitmap(F&& func);
+
+            std::vector<CustomBeatmapLevel*> _levels;
+            size_t _wordCount = 0;
+            /// @brief per bit the bitmap of levels that have it, empty if no level has the bit
+            std::array<Bitmap, DifficultyMask::BitCount> _bitmaps;
+            /// @brief per requirement id the bitmap of levels that have it on any difficulty, empty if no level has it
+            std::array<Bitmap, RequirementMask::MaxRequirements> _requirementBitmaps;
+            /// @brief bitmap of levels that have requirements on any difficulty
+            Bitmap _levelsWithRequirements;
+    };
+}
@@ -21,6 +21,7 @@
 #include "System/ValueTuple_2.hpp"
 #include "System/Collections/Generic/Dictionary_2.hpp"
 #include <filesystem>
+#include <memory>
 
 DECLARE_CLASS_CODEGEN(SongCore::SongLoader, LevelLoader, System::Object) {
     DECLARE_CTOR(ctor, GlobalNamespace::SpriteAsyncLoader* spriteAsyncLoader, GlobalNamespace::BeatmapCharacteristicCollection* beatmapCharacteristicCollection, GlobalNamespace::IAdditionalContentModel* additionalContentModel, GlobalNamespace::EnvironmentsListModel* environmentsListModel, SongCore::Characteristics* characteristics);
@@ -72,10 +73,12 @@ DECLARE_CLASS_CODEGEN(SongCore::SongLoader, LevelLoader, System::Object) {
         GlobalNamespace::FileSystemPreviewMediaData* GetPreviewMediaData(std::filesystem::path const& levelPath, StringW coverImageFilename, StringW songFilename);
 
         /// @brief beatmap level data from filesystem & basic beatmap data from savedata
-        std::pair<GlobalNamespace::FileSystemBeatmapLevelData*, BeatmapBasicDataDict*> GetBeatmapLevelAndBasicData(std::filesystem::path const& levelPath, std::string_view levelID, std::span<GlobalNamespace::EnvironmentName const> environmentNames, std::span<GlobalNamespace::ColorScheme* const> colorSchemes, CustomJSONData::CustomLevelInfoSaveDataV2* saveData);
+        /// @param difficultyMaskOut output for the characteristic x difficulty bitset of the loaded difficulties
+        std::pair<GlobalNamespace::FileSystemBeatmapLevelData*, BeatmapBasicDataDict*> GetBeatmapLevelAndBasicData(std::filesystem::path const& levelPath, std::string_view levelID, std::span<GlobalNamespace::EnvironmentName const> environmentNames, std::span<GlobalNamespace::ColorScheme* const> colorSchemes, CustomJSONData::CustomLevelInfoSaveDataV2* saveData, DifficultyMask& difficultyMaskOut);
 
         /// @brief beatmap level data from filesystem & basic beatmap data from savedata
-        std::pair<GlobalNamespace::FileSystemBeatmapLevelData*, BeatmapBasicDataDict*> GetBeatmapLevelAndBasicData(std::filesystem::path const& levelPath, std::string_view levelID, CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData);
+        /// @param difficultyMaskOut output for the characteristic x difficulty bitset of the loaded difficulties
+        std::pair<GlobalNamespace::FileSystemBeatmapLevelData*, BeatmapBasicDataDict*> GetBeatmapLevelAndBasicData(std::filesystem::path const& levelPath, std::string_view levelID, CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData, DifficultyMask& difficultyMaskOut);
 
         /// @brief gets the environment info for the environmentName and whether it's all directions or not
         GlobalNamespace::EnvironmentInfoSO* GetEnvironmentInfo(StringW environmentName, bool allDirections);
@@ -98,9 +101,13 @@ DECLARE_CLASS_CODEGEN(SongCore::SongLoader, LevelLoader, System::Object) {
         /// @brief calculates the song duration by parsing the first characteristic, first difficulty for the last note and seeing the time on it
         static float GetLengthFromMap(std::filesystem::path const& levelPath, CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData);
 
+        /// @brief builds the v3 savedata with custom data straight from the parsed info document, without going through the base game deserializer
+        /// @return the savedata, or nullptr if the document uses something that still needs the base game deserializer (color schemes)
+        SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* BuildCustomSaveData(std::shared_ptr<SongCore::CustomJSONData::DocumentUTF8 const> document, std::filesystem::path const& infoPath);
+
         /// @brief gets the v3 savedata with custom data from the base game save data
-        SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* LoadCustomSaveData(GlobalNamespace::StandardLevelInfoSaveData* saveData, std::u16string_view stringData);
+        SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* LoadCustomSaveData(GlobalNamespace::StandardLevelInfoSaveData* saveData, std::shared_ptr<SongCore::CustomJSONData::DocumentUTF8 const> document, std::filesystem::path const& infoPath = {});
 
         /// @brief gets the v4 savedata with custom data from the base game save data
-        SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* LoadCustomSaveData(BeatmapLevelSaveDataVersion4::BeatmapLevelSaveData* saveData, std::u16string_view stringData);
+        SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* LoadCustomSaveData(BeatmapLevelSaveDataVersion4::BeatmapLevelSaveData* saveData, std::shared_ptr<SongCore::CustomJSONData::DocumentUTF8 const> document, std::filesystem::path const& infoPath = {});
 };
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../_config.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace SongCore::SongLoader {
+    class CustomBeatmapLevel;
+
+    /// @brief thread safe native map from level path to loaded level. split over shards that each have their own lock, so loading threads rarely wait on each other.
+    /// the gc doesn't scan native memory, so every level in the registry is kept alive through a gc handle until it is removed
+    class SONGCORE_EXPORT LevelRegistry {
+        public:
+            static constexpr size_t ShardCount = 16;
+
+            LevelRegistry() = default;
+            ~LevelRegistry();
+            LevelRegistry(LevelRegistry const&) = delete;
+            LevelRegistry& operator=(LevelRegistry const&) = delete;
+
+            /// @brief gets the level at the path
+            /// @return nullptr if there is no level for the path
+            CustomBeatmapLevel* Find(std::string_view levelPath) const;
+
+            /// @brief adds the level for the path
+            /// @return whether it was added, false if the path already had a level
+            bool TryAdd(std::string_view levelPath, CustomBeatmapLevel* level);
+
+            /// @brief removes the level at the path
+            /// @return the removed level, nullptr if there was none
+            CustomBeatmapLevel* Remove(std::string_view levelPath);
+
+            /// @brief removes every level
+            void Clear();
+
+            /// @brief appends every level to out, in no particular order
+            void AppendLevels(std::vector<CustomBeatmapLevel*>& out) const;
+
+            /// @brief runs func for every path and level, each shard is locked while its levels are visited
+            void ForEach(std::function<void(std::string_view, CustomBeatmapLevel*)> const& func) const;
+
+            /// @brief how many levels there are
+            size_t get_Count() const { return _count.load(std::memory_order_relaxed); }
+            __declspec(property(get=get_Count)) size_t Count;
+
+            /// @brief bumped on every change, lets views built from the registry know when they are out of date
+            uint64_t get_Version() const { return _version.load(std::memory_order_acquire); }
+            __declspec(property(get=get_Version)) uint64_t Version;
+        private:
+            /// @brief hashes strings and string views the same, so lookups don't have to build a string
+            struct PathHash {
+                using is_transparent = void;
+                size_t operator()(std::string_view path) const { return std::hash<std::string_view>()(path); }
+            };
+
+            struct Entry {
+                CustomBeatmapLevel* level;
+                /// @brief gc handle keeping the level alive while it is in the registry
+                uint32_t gcHandle;
+            };
+
+            struct Shard {
+                mutable std::shared_mutex mutex;
+                std::unordered_map<std::string, Entry, PathHash, std::equal_to<>> levels;
+            };
+
+            Shard& GetShard(std::string_view levelPath);
+            Shard const& GetShard(std::string_view levelPath) const;
+
+            std::array<Shard, ShardCount> _shards;
+            std::atomic<size_t> _count = 0;
+            std::atomic<uint64_t> _version = 0;
+    };
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "../_config.h"
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace SongCore::SongLoader {
+    /// @brief bitset of interned requirement / capability ids. requirements and capabilities share the same ids, so checking requirements is a mask test
+    struct SONGCORE_EXPORT RequirementMask {
+        /// @brief max amount of distinct requirement strings that get an id, anything after that marks the mask as overflowed
+        static constexpr size_t MaxRequirements = 256;
+
+        std::bitset<MaxRequirements> bits;
+        /// @brief set when a requirement didn't get an id, such masks have to be checked by their strings instead
+        bool overflowed = false;
+
+        /// @brief sanitizes a requirement or capability the same way capability registration does, removing whitespace and lowercasing
+        static std::string Sanitize(std::string_view requirement);
+
+        /// @brief gets the id for the requirement, assigning a new one if this requirement was not seen before
+        /// @return id, or nullopt if all ids are taken
+        static std::optional<uint16_t> GetRequirementId(std::string_view requirement);
+
+        /// @brief gets the id for the requirement without assigning a new one
+        /// @return id, or nullopt if the requirement was never seen
+        static std::optional<uint16_t> FindRequirementId(std::string_view requirement);
+
+        /// @brief sets the bit for the requirement
+        RequirementMask& Set(std::string_view requirement);
+
+        /// @brief clears the bit for the requirement
+        RequirementMask& Reset(std::string_view requirement);
+
+        /// @brief whether the mask has the requirement
+        bool Has(std::string_view requirement) const;
+
+        /// @brief whether no requirement is set
+        bool Empty() const { return !overflowed && bits.none(); }
+
+        /// @brief whether every requirement in this mask is in the capabilities mask. overflowed masks never are
+        bool IsSatisfiedBy(RequirementMask const& capabilities) const { return !overflowed && (bits & ~capabilities.bits).none(); }
+
+        bool operator==(RequirementMask const& other) const = default;
+    };
+}
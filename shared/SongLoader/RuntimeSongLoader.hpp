@@ -1,11 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <future>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <filesystem>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
 #include <set>
 
 #include "beatsaber-hook/shared/callback.hpp"
@@ -15,6 +19,8 @@
 #include "CustomLevelPack.hpp"
 #include "CustomBeatmapLevel.hpp"
 #include "CustomBeatmapLevelsRepository.hpp"
+#include "LevelIndex.hpp"
+#include "LevelRegistry.hpp"
 
 #include "System/Collections/Concurrent/ConcurrentDictionary_2.hpp"
 #include "System/Collections/Generic/List_1.hpp"
@@ -59,9 +65,38 @@ DECLARE_CLASS_CODEGEN_INTERFACES(SongCore::SongLoader, RuntimeSongLoader, System
         /// @return shared future which you may await for when the songs are finished refreshing. if you want an onFinished use the `LevelsLoaded` event
         std::shared_future<void> RefreshSongs(bool fullRefresh = false);
 
-        /// @brief refreshes the level packs in the beatmaplevelsmodel
+        /// @brief reloads only the levels at the given paths, picking up changes to them without a full refresh. paths that no longer hold a level are dropped
+        /// @param levelPaths the level folders to reload
+        /// @return shared future which you may await for when the levels are done refreshing
+        std::shared_future<void> RefreshLevels(std::span<std::filesystem::path const> levelPaths);
+
+        /// @brief loads a single level, or reloads it if it was loaded already, updating the collections and packs in place instead of doing a full refresh
+        /// @param levelPath the level folder to load
+        /// @return shared future which you may await for when the level is loaded. the level itself is given by the `LevelAdded` event
+        std::shared_future<void> LoadLevel(std::filesystem::path const& levelPath);
+
+        /// @brief unloads a single level without touching it on disk, updating the collections and packs in place. it gets loaded again by the next refresh
+        /// @param levelPath the level folder to unload
+        /// @return shared future which you may await for when the level is unloaded
+        std::shared_future<void> UnloadLevel(std::filesystem::path const& levelPath);
+
+        /// @brief searches a single root folder, loading levels that are new in it and unloading the ones that are gone, without touching the other roots.
+        /// roots that aren't in the config stay loaded through later refreshes until UnloadLevelPath
+        /// @param root the root folder to search, levels in it count as wip if it is one of the wip roots in the config
+        /// @return shared future which you may await for when the root is done loading
+        std::shared_future<void> LoadLevelPath(std::filesystem::path const& root);
+
+        /// @brief unloads every level that was loaded from the root folder and forgets about the root, without touching the other roots
+        /// @param root the root folder to unload
+        /// @return shared future which you may await for when the root is unloaded
+        std::shared_future<void> UnloadLevelPath(std::filesystem::path const& root);
+
+        /// @brief refreshes the level packs in the beatmaplevelsmodel, should be ran on main thread
         void RefreshLevelPacks();
 
+        /// @brief sorts the custom level packs by the given field and refreshes the level packs, should be ran on main thread
+        void SortLevels(LevelSortField field);
+
         /// @brief delete a level by providing its level path
         std::future<void> DeleteSong(std::filesystem::path const& levelPath);
 
@@ -79,12 +114,12 @@ DECLARE_CLASS_CODEGEN_INTERFACES(SongCore::SongLoader, RuntimeSongLoader, System
         std::filesystem::path get_WIPSongPath() const;
         __declspec(property(get = get_WIPSongPath)) std::filesystem::path WIPSongPath;
 
-        /// @brief Returns the custom level dictionary
-        SongDict* get_customLevels() const { return _customLevels; };
+        /// @brief Returns the custom level dictionary. this is a view of the level partitions which gets brought up to date when it is requested, prefer GetLevelByPath
+        SongDict* get_customLevels();
         __declspec(property(get = get_customLevels)) SongLoader::SongDict* CustomLevels;
 
-        /// @brief Returns the custom wip level dictionary
-        SongDict* get_customWIPLevels() const { return _customWIPLevels; };
+        /// @brief Returns the custom wip level dictionary. this is a view of the level partitions which gets brought up to date when it is requested, prefer GetLevelByPath
+        SongDict* get_customWIPLevels();
         __declspec(property(get = get_customWIPLevels)) SongLoader::SongDict* CustomWIPLevels;
 
         /// @brief returns the levelpack songcore makes
@@ -99,18 +134,14 @@ DECLARE_CLASS_CODEGEN_INTERFACES(SongCore::SongLoader, RuntimeSongLoader, System
         CustomBeatmapLevelsRepository* get_CustomBeatmapLevelsRepository() const { return _customBeatmapLevelsRepository; }
         __declspec(property(get=get_CustomBeatmapLevelsRepository)) CustomBeatmapLevelsRepository* CustomBeatmapLevelsRepository;
 
-        /// @brief lets you check whether songs are currently being refreshed
-        bool get_AreSongsRefreshing() {
-            using namespace std::chrono_literals;
-            std::shared_lock<std::shared_mutex> lock(_currentRefreshMutex);
-            // if not valid, we are not refreshing
-            if (!_currentlyLoadingFuture.valid()) return false;
-            // if not ready, we are refreshing
-            return _currentlyLoadingFuture.wait_for(0ns) != std::future_status::ready;
-        }
-
+        /// @brief lets you check whether songs are currently being refreshed, including refreshes queued up behind the current one
+        bool get_AreSongsRefreshing() const { return _isRefreshing.load(std::memory_order_acquire); }
         __declspec(property(get=get_AreSongsRefreshing)) bool AreSongsRefreshing;
 
+        /// @brief runs the callback once songs are done refreshing, or right away on the calling thread if no refresh is going on.
+        /// callbacks queued during a refresh run on the refreshing thread, after SongsLoaded was invoked
+        void OnRefreshCompleted(std::function<void()> callback);
+
         /// @brief lets you check whether songs loaded are valid right now
         bool get_AreSongsLoaded() const { return _areSongsLoaded; }
         __declspec(property(get=get_AreSongsLoaded)) bool AreSongsLoaded;
@@ -127,10 +158,14 @@ DECLARE_CLASS_CODEGEN_INTERFACES(SongCore::SongLoader, RuntimeSongLoader, System
         size_t get_LoadedSongs() const { return (size_t)_loadedSongs; }
         __declspec(property(get=get_LoadedSongs)) size_t LoadedSongs;
 
-        /// @brief provides access into a span of all loaded levels
+        /// @brief provides access into a span of all loaded levels. refreshes and targeted loads change it on the main thread, so read it there and don't keep the span across frames
         std::span<CustomBeatmapLevel* const> get_AllLevels() const { return _allLoadedLevels; };
         __declspec(property(get=get_AllLevels)) std::span<CustomBeatmapLevel* const> AllLevels;
 
+        /// @brief provides access to the characteristic x difficulty index over all loaded levels, rebuilt on every refresh and updated in place by targeted loads. both happen on the main thread, so read it there
+        SongCore::SongLoader::LevelIndex const& get_LevelIndex() const { return _levelIndex; }
+        __declspec(property(get=get_LevelIndex)) SongCore::SongLoader::LevelIndex const& LevelIndex;
+
         /// @brief event invoked when songs will be refreshed
         unordered_event_callback<> SongsWillRefresh;
 
@@ -149,6 +184,12 @@ DECLARE_CLASS_CODEGEN_INTERFACES(SongCore::SongLoader, RuntimeSongLoader, System
         /// @brief event invoked after a song got deleted, so you may redo certain operations
         unordered_event_callback<> SongDeleted;
 
+        /// @brief event invoked after a targeted load added a level, ran on main thread. full refreshes only invoke SongsLoaded
+        unordered_event_callback<CustomBeatmapLevel*> LevelAdded;
+
+        /// @brief event invoked after a targeted unload or a deletion removed a level from every collection, ran on main thread
+        unordered_event_callback<CustomBeatmapLevel*> LevelRemoved;
+
         /// @brief gets a level by the levelpath
         /// @return nullptr if level not found
         CustomBeatmapLevel* GetLevelByPath(std::filesystem::path const& levelPath);
@@ -184,10 +225,23 @@ DECLARE_CLASS_CODEGEN_INTERFACES(SongCore::SongLoader, RuntimeSongLoader, System
         /// @return string view to the hash, or the entire levelid if not a custom level
         static std::u16string_view GetHashFromLevelID(std::u16string_view levelid);
     private:
+        /// @brief the levels loaded from one root folder. every root refreshes on its own, so adding or removing a root leaves the others alone
+        struct LevelPartition {
+            /// @brief the root folder, empty for the partition holding levels loaded from outside every root
+            std::filesystem::path root;
+            bool isWip = false;
+            /// @brief unique for the lifetime of the loader, so a dropped partition never looks like its replacement
+            uint64_t id = 0;
+            /// @brief the loaded levels of this root by path
+            SongCore::SongLoader::LevelRegistry levels;
+        };
+
         /// @brief internal struct to keep track of levelpath and wip status of a song before it got loaded
         struct LevelPathAndWip {
             std::filesystem::path levelPath;
             bool isWip;
+            /// @brief partition the level gets loaded into
+            LevelPartition* partition = nullptr;
 
             auto operator<=>(LevelPathAndWip const& other) const {
                 return levelPath <=> other.levelPath;
@@ -199,35 +253,105 @@ DECLARE_CLASS_CODEGEN_INTERFACES(SongCore::SongLoader, RuntimeSongLoader, System
         /// @return constructed color schemes
         ArrayW<GlobalNamespace::ColorScheme*> GetColorSchemes(std::span<GlobalNamespace::BeatmapLevelColorSchemeSaveData* const> colorSchemeDatas);
 
-        /// @brief collects levels from the root into the given set, and keeps the wip status
-        static void CollectLevels(std::filesystem::path const& root, bool isWip, std::set<LevelPathAndWip>& out);
+        /// @brief collects levels from the root of the partition into the given set, and keeps the wip status. folders of roots nested in it are left to their own partition
+        void CollectLevels(LevelPartition& partition, std::set<LevelPathAndWip>& out);
+
+        /// @brief whether the root is a wip root in the config. roots that are also listed as non wip roots are not
+        bool IsWipRoot(std::filesystem::path const& root) const;
+
+        /// @brief everything asked of one refresh pass. requests made while a pass is running are merged into a single follow-up pass
+        struct RefreshRequest {
+            /// @brief whether the song folders should be searched for new levels
+            bool collectAll = false;
+            /// @brief whether every level should be reloaded, this wins over everything else
+            bool full = false;
+            /// @brief level folders that should be reloaded
+            std::set<std::filesystem::path> levelPaths;
+            /// @brief level folders that should be unloaded, the last request for a path wins between this and levelPaths
+            std::set<std::filesystem::path> unloadPaths;
+            /// @brief root folders that should be searched on their own
+            std::set<std::filesystem::path> rootPaths;
+            /// @brief root folders whose levels should be unloaded, the last request for a root wins between this and rootPaths
+            std::set<std::filesystem::path> unloadRootPaths;
+            /// @brief completed once the pass is done
+            std::promise<void> promise;
+            std::shared_future<void> future = promise.get_future().share();
+
+            void Load(std::filesystem::path const& levelPath);
+            void Unload(std::filesystem::path const& levelPath);
+            void LoadRoot(std::filesystem::path const& root);
+            void UnloadRoot(std::filesystem::path const& root);
+        };
 
-        /// @brief collects levels from the roots into the given set, and keeps the wip status
-        static void CollectLevels(std::span<const std::filesystem::path> roots, bool isWip, std::set<LevelPathAndWip>& out);
+        /// @brief merges the request into the pending pass, or starts a pass if none is running
+        /// @param merge adds what is asked to the request, called while holding the refresh mutex
+        std::shared_future<void> QueueRefresh(std::function<void(RefreshRequest&)> const& merge);
 
-        /// @brief method used when a double (or triple, quadruple...) refresh is requested
-        void RefreshRequestedWhileRefreshing();
+        /// @brief runs the pass and any passes that got queued up during it, on one pool worker
+        void RunRefreshPasses(std::shared_ptr<RefreshRequest> request);
 
-        /// @brief method kicked of by RefreshSongs on an il2cpp async
-        void RefreshSongs_internal(bool fullRefresh);
+        /// @brief performs a single refresh pass
+        void RefreshSongs_internal(RefreshRequest const& request);
 
-        /// @brief worker thread for loading songs from a set
-        void RefreshSongWorkerThread(std::mutex* levelsItrMutex, std::set<LevelPathAndWip>::const_iterator* levelsItr, std::set<LevelPathAndWip>::const_iterator* levelsEnd);
+        /// @brief performs a targeted pass, which only loads and unloads the requested levels and updates every collection in place
+        void UpdateLevels_internal(RefreshRequest const& request);
 
-        /// @brief internal method for deleting a song, ran through il2cpp async
-        void DeleteSong_internal(std::filesystem::path levelPath);
+        /// @brief refreshes the levels of a single partition, ran in parallel for every partition during a pass
+        void RefreshPartition(LevelPartition& partition, RefreshRequest const& request);
 
-        /// @brief mutex for accesing the current refresh
-        std::shared_mutex _currentRefreshMutex;
-        /// @brief while songs are refreshing this future holds what is currently happening
-        std::shared_future<void> _currentlyLoadingFuture;
+        /// @brief worker thread for loading songs from a set
+        void RefreshSongWorkerThread(std::mutex* levelsItrMutex, std::set<LevelPathAndWip>::const_iterator* levelsItr, std::set<LevelPathAndWip>::const_iterator* levelsEnd);
 
-        /// @brief mutex for accesing the double refresh
-        std::shared_mutex _doubleRefreshMutex;
-        /// @brief if a request is sent for a double refresh (while refreshing) this stores the future of that request
-        std::shared_future<void> _doubleRefreshRequestedFuture;
-        /// @brief whether the double refresh should be a full refresh
-        bool _doubleRefreshIsFull;
+        /// @brief internal method for deleting a song, ran on the pool. deleted is completed once the level was unloaded and SongDeleted ran
+        void DeleteSong_internal(std::filesystem::path levelPath, std::shared_ptr<std::promise<void>> deleted);
+
+        /// @brief brings the managed dictionary view up to date with the partitions if any of them changed since the last sync
+        void SyncSongDict(SongDict* dict, bool isWip, std::vector<std::pair<uint64_t, uint64_t>>& syncedVersions);
+
+        /// @brief makes sure every root in the config and every root loaded through LoadLevelPath has a partition, and drops the partitions of the other roots.
+        /// roots the request unloads are dropped, and on a full request the levels loaded from outside every root as well
+        /// @return the partitions to refresh
+        std::vector<LevelPartition*> SyncPartitions(RefreshRequest const& request);
+        /// @brief remembers the roots the request loads that aren't in the config, and forgets the ones it unloads
+        void TrackExtraRoots(RefreshRequest const& request);
+        /// @brief gets the partition for the root, creating it if needed
+        LevelPartition& GetPartition(std::filesystem::path const& root, bool isWip);
+        /// @brief gets the partition of the deepest root holding the level, or the partition for levels outside every root
+        LevelPartition& GetPartitionFor(std::filesystem::path const& levelPath);
+        /// @brief finds the partition for the root
+        /// @return nullptr if the root has no partition
+        LevelPartition* FindPartition(std::filesystem::path const& root);
+        /// @brief forgets about the partition, its levels should have been removed already
+        void DropPartition(LevelPartition* partition);
+        /// @brief finds a loaded level by path in any partition
+        CustomBeatmapLevel* FindLevel(std::string_view levelPath) const;
+        /// @brief removes a loaded level by path from whichever partition holds it
+        /// @return the removed level, nullptr if it was not loaded
+        CustomBeatmapLevel* RemoveLevel(std::string_view levelPath);
+        /// @brief appends the levels of every partition with the given wip status
+        void AppendLevels(bool isWip, std::vector<CustomBeatmapLevel*>& out) const;
+
+        /// @brief mutex for the partition list, the partitions themselves are safe to use from any thread
+        mutable std::shared_mutex _partitionsMutex;
+        /// @brief one partition per root folder, and one for levels loaded from outside every root
+        std::vector<std::unique_ptr<LevelPartition>> _partitions;
+        uint64_t _nextPartitionId = 1;
+        /// @brief roots loaded through LoadLevelPath that aren't in the config, kept through refreshes until UnloadLevelPath. only touched by the passes
+        std::set<std::filesystem::path> _extraRootPaths;
+        /// @brief mutex for syncing the managed dictionaries
+        std::mutex _songDictSyncMutex;
+        /// @brief partition ids and versions the managed dictionaries were last synced at
+        std::vector<std::pair<uint64_t, uint64_t>> _customLevelsSyncedVersions;
+        std::vector<std::pair<uint64_t, uint64_t>> _customWIPLevelsSyncedVersions;
+
+        /// @brief mutex for the refresh state, pending pass and completion callbacks
+        std::mutex _refreshMutex;
+        /// @brief whether a pass is running, only written while holding the refresh mutex
+        std::atomic<bool> _isRefreshing;
+        /// @brief pass to run after the current one, nullptr if nothing was requested during it
+        std::shared_ptr<RefreshRequest> _pendingRefresh;
+        /// @brief callbacks waiting for the refreshes to complete
+        std::vector<std::function<void()>> _refreshCompletedCallbacks;
 
         /// @brief how many songs have already been loaded
         std::atomic<size_t> _loadedSongs;
@@ -241,6 +365,8 @@ DECLARE_CLASS_CODEGEN_INTERFACES(SongCore::SongLoader, RuntimeSongLoader, System
         std::unordered_map<std::string, CustomBeatmapLevel*> _levelIdsToLevels;
         /// @brief collection holding the hashes to levels
         std::unordered_map<std::string, CustomBeatmapLevel*> _hashesToLevels;
+        /// @brief characteristic x difficulty index over all loaded levels
+        SongCore::SongLoader::LevelIndex _levelIndex;
 
         static RuntimeSongLoader* _instance;
 
@@ -256,4 +382,8 @@ DECLARE_CLASS_CODEGEN_INTERFACES(SongCore::SongLoader, RuntimeSongLoader, System
         void InvokeSongWillBeDeleted(CustomBeatmapLevel* level) const;
         /// @brief invoker method for SongDeleted event
         void InvokeSongDeleted() const;
+        /// @brief invoker method for LevelAdded event
+        void InvokeLevelAdded(CustomBeatmapLevel* level) const;
+        /// @brief invoker method for LevelRemoved event
+        void InvokeLevelRemoved(CustomBeatmapLevel* level) const;
 };
@@ -24,6 +24,10 @@ namespace SongCore {
         return SongCore::API::Capabilities::IsCapabilityRegistered(capability);
     }
 
+    bool Capabilities::AreRequirementsMet(SongLoader::CustomBeatmapLevel* level, std::string_view characteristic, GlobalNamespace::BeatmapDifficulty difficulty) const {
+        return SongCore::API::Capabilities::AreRequirementsMet(level, characteristic, difficulty);
+    }
+
     std::span<const std::string> Capabilities::GetRegisteredCapabilities() const {
         return SongCore::API::Capabilities::GetRegisteredCapabilities();
     }
@@ -1,8 +1,21 @@
 #include "CustomJSONData.hpp"
 #include "paper2_scotland2/shared/utfcpp/source/utf8.h"
+#include "beatsaber-hook/shared/rapidjson/include/rapidjson/stringbuffer.h"
+#include "beatsaber-hook/shared/rapidjson/include/rapidjson/writer.h"
+#include "beatsaber-hook/shared/rapidjson/include/rapidjson/pointer.h"
 #include "logging.hpp"
+#include "Utils/File.hpp"
+#include "Utils/FieldTable.hpp"
+#include "Utils/JsonArena.hpp"
+#include "Utils/MainThread.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <iterator>
+#include <list>
+#include <mutex>
 #include <string>
+#include <type_traits>
 
 using namespace GlobalNamespace;
 
@@ -60,13 +73,13 @@ namespace SongCore::CustomJSONData {
 	}
 
 	std::optional<std::reference_wrapper<const CustomSaveDataInfo::BasicCustomLevelDetails>> CustomSaveDataInfo::TryGetBasicLevelDetails() {
-		ParseLevelDetails();
-		return _cachedLevelDetails;
+		if (!ParseLevelDetails()) return std::nullopt;
+		return *_levelDetails.details;
 	}
 
 	bool CustomSaveDataInfo::TryGetBasicLevelDetails(BasicCustomLevelDetails& outDetails) {
 		if (ParseLevelDetails()) {
-			outDetails = _cachedLevelDetails.value();
+			outDetails = *_levelDetails.details;
 			return true;
 		}
 		return false;
@@ -74,66 +87,129 @@ namespace SongCore::CustomJSONData {
 
 	std::optional<std::reference_wrapper<CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetailsSet const>> CustomSaveDataInfo::TryGetCharacteristic(std::string const& characteristic) {
 		if (ParseLevelDetails()) {
-			return _cachedLevelDetails->TryGetCharacteristic(characteristic);
+			return _levelDetails.details->TryGetCharacteristic(characteristic);
 		}
 		return std::nullopt;
 	}
 
 	bool CustomSaveDataInfo::TryGetCharacteristic(std::string const& characteristic, CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetailsSet& outSet) {
 		if (ParseLevelDetails()) {
-			return _cachedLevelDetails->TryGetCharacteristic(characteristic, outSet);
+			return _levelDetails.details->TryGetCharacteristic(characteristic, outSet);
 		}
 		return false;
 	}
 
 	std::optional<std::reference_wrapper<CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails const>> CustomSaveDataInfo::TryGetCharacteristicAndDifficulty(std::string const& characteristic, GlobalNamespace::BeatmapDifficulty difficulty) {
 		if (ParseLevelDetails()) {
-			return _cachedLevelDetails->TryGetCharacteristicAndDifficulty(characteristic, difficulty);
+			return _levelDetails.details->TryGetCharacteristicAndDifficulty(characteristic, difficulty);
 		}
 		return std::nullopt;
 	}
 
 	bool CustomSaveDataInfo::TryGetCharacteristicAndDifficulty(std::string const& characteristic, GlobalNamespace::BeatmapDifficulty difficulty, CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails& outDetails) {
 		if (ParseLevelDetails()) {
-			return _cachedLevelDetails->TryGetCharacteristicAndDifficulty(characteristic, difficulty, outDetails);
+			return _levelDetails.details->TryGetCharacteristicAndDifficulty(characteristic, difficulty, outDetails);
 		}
 		return false;
 	}
 
-	bool CustomSaveDataInfo::ParseLevelDetails() {
-		if (_cachedLevelDetails.has_value()) return true;
-		BasicCustomLevelDetails levelDetails;
+	static std::atomic<size_t> _mainThreadParseCount = 0;
+
+	size_t CustomSaveDataInfo::GetMainThreadParseCount() {
+		return _mainThreadParseCount.load(std::memory_order_relaxed);
+	}
+
+	bool CustomSaveDataInfo::PrepareLevelDetails() {
+		return ParseLevelDetails();
+	}
+
+	void CustomSaveDataInfo::SetLevelDetails(std::shared_ptr<BasicCustomLevelDetails const> details) {
+		uint8_t expected = LevelDetailsSlot::NotParsed;
+		if (!details || !_levelDetails.state.compare_exchange_strong(expected, LevelDetailsSlot::Parsing, std::memory_order_acquire)) return;
+
+		_levelDetails.details = std::move(details);
+		_levelDetails.state.store(LevelDetailsSlot::Ready, std::memory_order_release);
+		_levelDetails.state.notify_all();
+	}
+
+	/// @brief parses the level details from the document of the save data
+	/// @return the parsed details, nullptr if parsing failed
+	static std::shared_ptr<CustomSaveDataInfo::BasicCustomLevelDetails const> ParseDetailsFromDocument(CustomSaveDataInfo const& info) {
+		if (Utils::IsMainThread()) {
+			auto count = _mainThreadParseCount.fetch_add(1, std::memory_order_relaxed) + 1;
+			WARNING("Parsing level details on the main thread for {} ({} times so far)", info.document ? info.document->path.string() : "unknown level", count);
+		}
+
+		auto document = info.get_docUTF8();
+		if (!document) {
+			ERROR("Save data has no document to parse level details from!");
+			return nullptr;
+		}
+		auto levelDetails = std::make_shared<CustomSaveDataInfo::BasicCustomLevelDetails>();
 
-		switch(saveDataVersion) {
-			case SaveDataVersion::Unknown: {
+		switch(info.saveDataVersion) {
+			case CustomSaveDataInfo::SaveDataVersion::Unknown: {
 				ERROR("Save data version was never set, this is invalid behaviour! returning false for parsed level details!");
-				return false;
+				return nullptr;
 			} break;
-			case SaveDataVersion::V3: {
-				if (!levelDetails.DeserializeV3(doc->GetObject())) {
+			case CustomSaveDataInfo::SaveDataVersion::V3: {
+				if (!levelDetails->DeserializeV3(*document)) {
 					ERROR("Failed to parse save data as v3 savedata");
-					return false;
+					return nullptr;
 				}
 			} break;
-			case SaveDataVersion::V4: {
-				if (!levelDetails.DeserializeV4(doc->GetObject())) {
+			case CustomSaveDataInfo::SaveDataVersion::V4: {
+				if (!levelDetails->DeserializeV4(*document)) {
 					ERROR("Failed to parse save data as v4 savedata");
-					return false;
+					return nullptr;
 				}
 			} break;
 		};
-		_cachedLevelDetails = std::move(levelDetails);
-		return true;
+		return levelDetails;
+	}
+
+	bool CustomSaveDataInfo::ParseLevelDetails() {
+		auto& state = _levelDetails.state;
+		uint8_t current = state.load(std::memory_order_acquire);
+		if (current == LevelDetailsSlot::Ready) return true;
+
+		// exactly one thread gets to move the state to parsing, that thread does the parse
+		if (current == LevelDetailsSlot::NotParsed && state.compare_exchange_strong(current, LevelDetailsSlot::Parsing, std::memory_order_acquire)) {
+			auto details = ParseDetailsFromDocument(*this);
+			bool parsed = details != nullptr;
+			if (parsed) {
+				_levelDetails.details = std::move(details);
+				// the details are never written again after this, so readers can hold references to them
+				state.store(LevelDetailsSlot::Ready, std::memory_order_release);
+			} else {
+				// failures are not remembered, a later call tries again
+				state.store(LevelDetailsSlot::NotParsed, std::memory_order_release);
+			}
+			state.notify_all();
+			// another thread may be parsing again by now, so don't read the slot after releasing it
+			return parsed;
+		}
+
+		// someone else is parsing, wait for them instead of parsing twice
+		while ((current = state.load(std::memory_order_acquire)) == LevelDetailsSlot::Parsing) {
+			state.wait(LevelDetailsSlot::Parsing, std::memory_order_acquire);
+		}
+		return current == LevelDetailsSlot::Ready;
 	}
 
 	std::optional<std::reference_wrapper<CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetailsSet const>> CustomSaveDataInfo::BasicCustomLevelDetails::TryGetCharacteristic(std::string const& characteristic) const {
-		auto charItr = characteristicNameToBeatmapDetailsSet.find(characteristic);
+		// a name that was never interned can not be in the map
+		auto name = InternedString::Find(characteristic);
+		if (!name) return std::nullopt;
+		auto charItr = characteristicNameToBeatmapDetailsSet.find(*name);
 		if (charItr != characteristicNameToBeatmapDetailsSet.end()) return charItr->second;
 		return std::nullopt;
 	}
 
 	bool CustomSaveDataInfo::BasicCustomLevelDetails::TryGetCharacteristic(std::string const& characteristic, CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetailsSet& outDetailsSet) const {
-		auto charItr = characteristicNameToBeatmapDetailsSet.find(characteristic);
+		auto name = InternedString::Find(characteristic);
+		if (!name) return false;
+		auto charItr = characteristicNameToBeatmapDetailsSet.find(*name);
 		if (charItr != characteristicNameToBeatmapDetailsSet.end()) {
 			outDetailsSet = charItr->second;
 			return true;
@@ -142,17 +218,50 @@ namespace SongCore::CustomJSONData {
 	}
 
 	std::optional<std::reference_wrapper<CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails const>> CustomSaveDataInfo::BasicCustomLevelDetails::TryGetCharacteristicAndDifficulty(std::string const& characteristic, GlobalNamespace::BeatmapDifficulty difficulty) const {
-		auto charItr = characteristicNameToBeatmapDetailsSet.find(characteristic);
+		auto name = InternedString::Find(characteristic);
+		if (!name) return std::nullopt;
+		auto charItr = characteristicNameToBeatmapDetailsSet.find(*name);
 		if (charItr != characteristicNameToBeatmapDetailsSet.end()) return charItr->second.TryGetDifficulty(difficulty);
 		return std::nullopt;
 	}
 
 	bool CustomSaveDataInfo::BasicCustomLevelDetails::TryGetCharacteristicAndDifficulty(std::string const& characteristic, GlobalNamespace::BeatmapDifficulty difficulty, BasicCustomDifficultyBeatmapDetails& outDetails) const {
-		auto charItr = characteristicNameToBeatmapDetailsSet.find(characteristic);
+		auto name = InternedString::Find(characteristic);
+		if (!name) return false;
+		auto charItr = characteristicNameToBeatmapDetailsSet.find(*name);
 		if (charItr != characteristicNameToBeatmapDetailsSet.end()) return charItr->second.TryGetDifficulty(difficulty, outDetails);
 		return false;
 	}
 
+	/// @brief picks the member name literal matching the encoding of the value being read
+	template<typename Ch>
+	static constexpr Ch const* Key(char const* utf8Key, char16_t const* utf16Key) {
+		if constexpr (std::is_same_v<Ch, char16_t>) return utf16Key;
+		else return utf8Key;
+	}
+
+	#define KEY(str) Key<typename ValueT::Ch>(str, u"" str)
+
+	/// @brief gets the string value as utf8, without converting if the document already is utf8
+	template<typename ValueT>
+	static std::string GetUTF8String(ValueT const& value) {
+		if constexpr (std::is_same_v<typename ValueT::Ch, char16_t>) return utf8::utf16to8(std::u16string_view(value.GetString(), value.GetStringLength()));
+		else return std::string(value.GetString(), value.GetStringLength());
+	}
+
+	/// @brief interns a json string. utf8 documents are interned directly, utf16 ones get converted through a reused buffer
+	template<typename ValueT>
+	static InternedString InternString(ValueT const& value) {
+		if constexpr (std::is_same_v<typename ValueT::Ch, char16_t>) {
+			thread_local std::string buffer;
+			buffer.clear();
+			utf8::utf16to8(value.GetString(), value.GetString() + value.GetStringLength(), std::back_inserter(buffer));
+			return InternedString(buffer);
+		} else {
+			return InternedString(std::string_view(value.GetString(), value.GetStringLength()));
+		}
+	}
+
 	static GlobalNamespace::BeatmapDifficulty ParseDiff(std::string_view diffName) {
 		static std::pair<std::string, GlobalNamespace::BeatmapDifficulty> diffNameToDiffMap[6] {
 			{ "Easy", GlobalNamespace::BeatmapDifficulty::Easy },
@@ -171,314 +280,606 @@ namespace SongCore::CustomJSONData {
 		return GlobalNamespace::BeatmapDifficulty::Easy;
 	}
 
-	static void ParseContributorArrayInto(ValueUTF16 const& customData, CustomSaveDataInfo::SaveDataVersion version, std::vector<CustomSaveDataInfo::BasicCustomLevelDetails::Contributor>& out) {
-		switch (version) {
-			case CustomSaveDataInfo::SaveDataVersion::V3: {
-				auto arrayItr = customData.FindMember(u"_contributors");
-				if (arrayItr == customData.MemberEnd() || !arrayItr->value.IsArray()) return;
-				for (auto& value : arrayItr->value.GetArray()) {
-					out.emplace_back().DeserializeV3(value);
-				}
-			} break;
-			case CustomSaveDataInfo::SaveDataVersion::V4: {
-				auto arrayItr = customData.FindMember(u"contributors");
-				if (arrayItr == customData.MemberEnd() || !arrayItr->value.IsArray()) return;
-				for (auto& value : arrayItr->value.GetArray()) {
-					out.emplace_back().DeserializeV4(value);
-				}
-			} break;
-			case CustomSaveDataInfo::SaveDataVersion::Unknown: {} break;
+	using LevelDetails = CustomSaveDataInfo::BasicCustomLevelDetails;
+	using Contributor = CustomSaveDataInfo::BasicCustomLevelDetails::Contributor;
+	using DetailsSet = CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetailsSet;
+	using DifficultyDetails = CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails;
+	using CustomColors = CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails::CustomColors;
+
+	/// @brief the struct a member pointer points into
+	template<typename T> struct MemberOwner;
+	template<typename C, typename M> struct MemberOwner<M C::*> { using type = C; };
+	template<auto Member> using OwnerOf = typename MemberOwner<decltype(Member)>::type;
+
+	// readers for the field tables, Member is the field the json value gets written into
+
+	template<auto Member, typename ValueT>
+	static bool ReadStringField(OwnerOf<Member>& target, ValueT const& value) {
+		if (!value.IsString()) return false;
+		target.*Member = GetUTF8String(value);
+		return true;
+	}
+
+	template<auto Member, typename ValueT>
+	static bool ReadInternedField(OwnerOf<Member>& target, ValueT const& value) {
+		if (!value.IsString()) return false;
+		target.*Member = InternString(value);
+		return true;
+	}
+
+	template<auto Member, typename ValueT>
+	static bool ReadInternedArrayField(OwnerOf<Member>& target, ValueT const& value) {
+		if (!value.IsArray()) return false;
+		auto& out = target.*Member;
+		out.reserve(out.size() + value.Size());
+		for (auto& entry : value.GetArray()) {
+			if (entry.IsString()) out.emplace_back(InternString(entry));
 		}
+		return true;
 	}
 
-	// this is all the characteristics -> diff sets
-	bool CustomSaveDataInfo::BasicCustomLevelDetails::Deserialize(ValueUTF16 const& value) {
-		return DeserializeV3(value);
+	template<auto Member, typename ValueT>
+	static bool ReadBoolField(OwnerOf<Member>& target, ValueT const& value) {
+		if (!value.IsBool()) return false;
+		target.*Member = value.GetBool();
+		return true;
 	}
 
-	bool CustomSaveDataInfo::BasicCustomLevelDetails::DeserializeV3(ValueUTF16 const& value) {
-		auto memberEnd = value.MemberEnd();
-		bool foundEverything = true;
-		auto difficultyBeatmapSetsItr = value.FindMember(u"_difficultyBeatmapSets");
-		if (difficultyBeatmapSetsItr != memberEnd && difficultyBeatmapSetsItr->value.IsArray()) {
-			// check each set
-			for (auto& set : difficultyBeatmapSetsItr->value.GetArray()) {
-				auto characteristicName = utf8::utf16to8(set[u"_beatmapCharacteristicName"].Get<std::u16string>());
-				auto& diffSet = characteristicNameToBeatmapDetailsSet[characteristicName];
-				diffSet.characteristicName = characteristicName;
-				diffSet.DeserializeV3(set);
+	/// @brief color objects are always a handful of single letter members, so they skip the field tables and switch on the letter
+	template<typename ValueT>
+	static UnityEngine::Color DeserializeColor(ValueT const& value) {
+		UnityEngine::Color color(1.0f, 1.0f, 1.0f, 1.0f);
+		for (auto itr = value.MemberBegin(); itr != value.MemberEnd(); ++itr) {
+			if (itr->name.GetStringLength() != 1 || !itr->value.IsNumber()) continue;
+			switch (itr->name.GetString()[0]) {
+				case 'r': color.r = itr->value.GetFloat(); break;
+				case 'g': color.g = itr->value.GetFloat(); break;
+				case 'b': color.b = itr->value.GetFloat(); break;
+				case 'a': color.a = itr->value.GetFloat(); break;
+				default: break;
 			}
-		} else {
-			foundEverything = false;
 		}
+		return color;
+	}
 
-		auto customDataItr = value.FindMember(u"_customData");
-		if (customDataItr != memberEnd && customDataItr->value.IsObject()) {
-			ParseContributorArrayInto(customDataItr->value, CustomSaveDataInfo::SaveDataVersion::V3, contributors);
-		}
+	template<CustomColors::Slot Slot, typename ValueT>
+	static bool ReadColorSlot(CustomColors& colors, ValueT const& value) {
+		if (!value.IsObject()) return false;
+		colors.Set(Slot, DeserializeColor(value));
+		return true;
+	}
 
-		return foundEverything;
+	template<typename ValueT>
+	static bool ReadContributorsV3(LevelDetails& details, ValueT const& value) {
+		if (!value.IsArray()) return false;
+		for (auto& entry : value.GetArray()) details.contributors.emplace_back().DeserializeV3(entry);
+		return true;
 	}
 
-	bool CustomSaveDataInfo::BasicCustomLevelDetails::DeserializeV4(ValueUTF16 const& value) {
-		auto memberEnd = value.MemberEnd();
-		bool foundEverything = true;
-		auto difficultyBeatmapsItr = value.FindMember(u"difficultyBeatmaps");
-		if (difficultyBeatmapsItr != memberEnd && difficultyBeatmapsItr->value.IsArray()) {
-			// check each set
-			for (auto& beatmap : difficultyBeatmapsItr->value.GetArray()) {
-				auto characteristicName = utf8::utf16to8(beatmap[u"characteristic"].Get<std::u16string>());
-				auto difficultyName = utf8::utf16to8(beatmap[u"difficulty"].Get<std::u16string>());
-				auto difficulty = ParseDiff(difficultyName);
-
-				auto& characteristic = characteristicNameToBeatmapDetailsSet[characteristicName];
-				characteristic.characteristicName = characteristicName;
-				auto& diff = characteristic.difficultyToDifficultyBeatmapDetails[difficulty];
-				diff.characteristicName = characteristicName;
-				diff.DeserializeV4(beatmap);
-			}
-		} else {
-			foundEverything = false;
+	template<typename ValueT>
+	static bool ReadContributorsV4(LevelDetails& details, ValueT const& value) {
+		if (!value.IsArray()) return false;
+		for (auto& entry : value.GetArray()) details.contributors.emplace_back().DeserializeV4(entry);
+		return true;
+	}
+
+	template<typename ValueT>
+	static constexpr auto LevelCustomDataFieldsV3 = Utils::MakeFieldTable<LevelDetails, ValueT>({
+		{ "_contributors", &ReadContributorsV3<ValueT> },
+	});
+
+	template<typename ValueT>
+	static bool ReadLevelCustomDataV3(LevelDetails& details, ValueT const& value) {
+		if (!value.IsObject()) return false;
+		LevelCustomDataFieldsV3<ValueT>.Read(details, value);
+		return true;
+	}
+
+	// this is all the characteristics -> diff sets
+	template<typename ValueT>
+	static bool ReadDifficultyBeatmapSetsV3(LevelDetails& details, ValueT const& value) {
+		if (!value.IsArray()) return false;
+		// check each set
+		for (auto& set : value.GetArray()) {
+			auto characteristicName = InternString(set[KEY("_beatmapCharacteristicName")]);
+			auto& diffSet = details.characteristicNameToBeatmapDetailsSet[characteristicName];
+			diffSet.characteristicName = characteristicName;
+			diffSet.DeserializeV3(set);
 		}
+		return true;
+	}
 
-		auto customDataItr = value.FindMember(u"customData");
-		if (customDataItr != memberEnd && customDataItr->value.IsObject()) {
-			ParseContributorArrayInto(customDataItr->value, CustomSaveDataInfo::SaveDataVersion::V4, contributors);
+	template<typename ValueT>
+	static constexpr auto LevelFieldsV3 = Utils::MakeFieldTable<LevelDetails, ValueT>({
+		{ "_difficultyBeatmapSets", &ReadDifficultyBeatmapSetsV3<ValueT> },
+		{ "_customData", &ReadLevelCustomDataV3<ValueT> },
+	});
 
-			auto characteristicDataItr = customDataItr->value.FindMember(u"characteristicData");
-			if (characteristicDataItr != customDataItr->value.MemberEnd() && characteristicDataItr->value.IsArray()) {
-				for (auto& data : characteristicDataItr->value.GetArray()) {
-					auto characteristicName = utf8::utf16to8(data[u"characteristic"].Get<std::u16string>());
-					auto& characteristic = characteristicNameToBeatmapDetailsSet[characteristicName];
-					characteristic.DeserializeV4(data);
-				}
-			}
+	template<typename ValueT>
+	static bool ReadCharacteristicDataV4(LevelDetails& details, ValueT const& value) {
+		if (!value.IsArray()) return false;
+		for (auto& data : value.GetArray()) {
+			auto characteristicName = InternString(data[KEY("characteristic")]);
+			auto& characteristic = details.characteristicNameToBeatmapDetailsSet[characteristicName];
+			characteristic.DeserializeV4(data);
 		}
+		return true;
+	}
+
+	template<typename ValueT>
+	static constexpr auto LevelCustomDataFieldsV4 = Utils::MakeFieldTable<LevelDetails, ValueT>({
+		{ "contributors", &ReadContributorsV4<ValueT> },
+		{ "characteristicData", &ReadCharacteristicDataV4<ValueT> },
+	});
+
+	template<typename ValueT>
+	static bool ReadLevelCustomDataV4(LevelDetails& details, ValueT const& value) {
+		if (!value.IsObject()) return false;
+		LevelCustomDataFieldsV4<ValueT>.Read(details, value);
+		return true;
+	}
+
+	template<typename ValueT>
+	static bool ReadDifficultyBeatmapsV4(LevelDetails& details, ValueT const& value) {
+		if (!value.IsArray()) return false;
+		for (auto& beatmap : value.GetArray()) {
+			auto characteristicName = InternString(beatmap[KEY("characteristic")]);
+			auto difficultyName = GetUTF8String(beatmap[KEY("difficulty")]);
+			auto difficulty = ParseDiff(difficultyName);
+
+			auto& characteristic = details.characteristicNameToBeatmapDetailsSet[characteristicName];
+			characteristic.characteristicName = characteristicName;
+			auto& diff = characteristic.difficultyToDifficultyBeatmapDetails[difficulty];
+			diff.characteristicName = characteristicName;
+			diff.difficulty = difficulty;
+			diff.DeserializeV4(beatmap);
+		}
+		return true;
+	}
+
+	template<typename ValueT>
+	static constexpr auto LevelFieldsV4 = Utils::MakeFieldTable<LevelDetails, ValueT>({
+		{ "difficultyBeatmaps", &ReadDifficultyBeatmapsV4<ValueT> },
+		{ "customData", &ReadLevelCustomDataV4<ValueT> },
+	});
+
+	template<typename ValueT>
+	static bool DeserializeLevelDetailsV3(LevelDetails& details, ValueT const& value) {
+		auto found = LevelFieldsV3<ValueT>.Read(details, value);
+		return found & LevelFieldsV3<ValueT>.Bit("_difficultyBeatmapSets");
+	}
+
+	template<typename ValueT>
+	static bool DeserializeLevelDetailsV4(LevelDetails& details, ValueT const& value) {
+		auto found = LevelFieldsV4<ValueT>.Read(details, value);
+		return found & LevelFieldsV4<ValueT>.Bit("difficultyBeatmaps");
+	}
+
+	bool CustomSaveDataInfo::BasicCustomLevelDetails::Deserialize(ValueUTF16 const& value) {
+		return DeserializeV3(value);
+	}
+
+	bool CustomSaveDataInfo::BasicCustomLevelDetails::DeserializeV3(ValueUTF16 const& value) {
+		return DeserializeLevelDetailsV3(*this, value);
+	}
+
+	bool CustomSaveDataInfo::BasicCustomLevelDetails::DeserializeV3(ValueUTF8 const& value) {
+		return DeserializeLevelDetailsV3(*this, value);
+	}
 
-		return foundEverything;
+	bool CustomSaveDataInfo::BasicCustomLevelDetails::DeserializeV4(ValueUTF16 const& value) {
+		return DeserializeLevelDetailsV4(*this, value);
+	}
+
+	bool CustomSaveDataInfo::BasicCustomLevelDetails::DeserializeV4(ValueUTF8 const& value) {
+		return DeserializeLevelDetailsV4(*this, value);
 	}
 
+	template<typename ValueT>
+	static constexpr auto ContributorFieldsV3 = Utils::MakeFieldTable<Contributor, ValueT>({
+		{ "_name", &ReadInternedField<&Contributor::name, ValueT> },
+		{ "_role", &ReadInternedField<&Contributor::role, ValueT> },
+		{ "_iconPath", &ReadStringField<&Contributor::iconPath, ValueT> },
+	});
+
+	template<typename ValueT>
+	static constexpr auto ContributorFieldsV4 = Utils::MakeFieldTable<Contributor, ValueT>({
+		{ "name", &ReadInternedField<&Contributor::name, ValueT> },
+		{ "role", &ReadInternedField<&Contributor::role, ValueT> },
+		{ "iconPath", &ReadStringField<&Contributor::iconPath, ValueT> },
+	});
+
 	bool CustomSaveDataInfo::BasicCustomLevelDetails::Contributor::Deserialize(ValueUTF16 const& value) {
 		return DeserializeV3(value);
 	}
 
 	bool CustomSaveDataInfo::BasicCustomLevelDetails::Contributor::DeserializeV3(ValueUTF16 const& value) {
-		auto memberEnd = value.MemberEnd();
-		auto nameItr = value.FindMember(u"_name");
-		if (nameItr != memberEnd) name = utf8::utf16to8(nameItr->value.Get<std::u16string>());
-		auto roleItr = value.FindMember(u"_role");
-		if (roleItr != memberEnd) role = utf8::utf16to8(roleItr->value.Get<std::u16string>());
-		auto iconPathItr = value.FindMember(u"_iconPath");
-		if (iconPathItr != memberEnd) iconPath = utf8::utf16to8(iconPathItr->value.Get<std::u16string>());
+		ContributorFieldsV3<ValueUTF16>.Read(*this, value);
+		return true;
+	}
 
+	bool CustomSaveDataInfo::BasicCustomLevelDetails::Contributor::DeserializeV3(ValueUTF8 const& value) {
+		ContributorFieldsV3<ValueUTF8>.Read(*this, value);
 		return true;
 	}
 
 	bool CustomSaveDataInfo::BasicCustomLevelDetails::Contributor::DeserializeV4(ValueUTF16 const& value) {
-		auto memberEnd = value.MemberEnd();
-		auto nameItr = value.FindMember(u"name");
-		if (nameItr != memberEnd) name = utf8::utf16to8(nameItr->value.Get<std::u16string>());
-		auto roleItr = value.FindMember(u"role");
-		if (roleItr != memberEnd) role = utf8::utf16to8(roleItr->value.Get<std::u16string>());
-		auto iconPathItr = value.FindMember(u"iconPath");
-		if (iconPathItr != memberEnd) iconPath = utf8::utf16to8(iconPathItr->value.Get<std::u16string>());
+		ContributorFieldsV4<ValueUTF16>.Read(*this, value);
+		return true;
+	}
 
+	bool CustomSaveDataInfo::BasicCustomLevelDetails::Contributor::DeserializeV4(ValueUTF8 const& value) {
+		ContributorFieldsV4<ValueUTF8>.Read(*this, value);
 		return true;
 	}
 
 	std::optional<std::reference_wrapper<CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails const>> CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetailsSet::TryGetDifficulty(GlobalNamespace::BeatmapDifficulty difficulty) const {
-		auto diffItr = difficultyToDifficultyBeatmapDetails.find(difficulty);
-		if (diffItr != difficultyToDifficultyBeatmapDetails.end()) return diffItr->second;
+		if (auto details = difficultyToDifficultyBeatmapDetails.Find(difficulty)) return *details;
 		return std::nullopt;
 	}
 
 	bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetailsSet::TryGetDifficulty(GlobalNamespace::BeatmapDifficulty difficulty, CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails& outDetails) const {
-		auto diffItr = difficultyToDifficultyBeatmapDetails.find(difficulty);
-		if (diffItr != difficultyToDifficultyBeatmapDetails.end()) {
-			outDetails = diffItr->second;
+		if (auto details = difficultyToDifficultyBeatmapDetails.Find(difficulty)) {
+			outDetails = *details;
 			return true;
 		}
 		return false;
 	}
 
-	// this is the diff set -> difficulties
-	bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetailsSet::Deserialize(ValueUTF16 const& value) {
-		return DeserializeV3(value);
-	}
+	template<typename ValueT>
+	static constexpr auto DetailsSetCustomDataFieldsV3 = Utils::MakeFieldTable<DetailsSet, ValueT>({
+		{ "_characteristicLabel", &ReadStringField<&DetailsSet::characteristicLabel, ValueT> },
+		{ "_characteristicIconImageFilename", &ReadStringField<&DetailsSet::characteristicIconImageFileName, ValueT> },
+	});
 
-	bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetailsSet::DeserializeV3(ValueUTF16 const& value) {
-		auto memberEnd = value.MemberEnd();
-		auto customDataItr = value.FindMember(u"_customData");
-		if (customDataItr != memberEnd && customDataItr->value.IsObject()) {
-			auto& customData = customDataItr->value;
-			auto memberEnd = customData.MemberEnd();
-
-			auto characteristicLabelItr = customData.FindMember(u"_characteristicLabel");
-			if (characteristicLabelItr != memberEnd) characteristicLabel = utf8::utf16to8(characteristicLabelItr->value.Get<std::u16string>());
-
-			auto characteristicIconImageFileNameItr = customData.FindMember(u"_characteristicIconImageFilename");
-			if (characteristicIconImageFileNameItr != memberEnd) characteristicIconImageFileName = utf8::utf16to8(characteristicIconImageFileNameItr->value.Get<std::u16string>());
-		}
-
-		auto difficultyBeatmapsItr = value.FindMember(u"_difficultyBeatmaps");
-		if (difficultyBeatmapsItr == memberEnd || !difficultyBeatmapsItr->value.IsArray()) return false;
+	template<typename ValueT>
+	static bool ReadDetailsSetCustomDataV3(DetailsSet& detailsSet, ValueT const& value) {
+		if (!value.IsObject()) return false;
+		DetailsSetCustomDataFieldsV3<ValueT>.Read(detailsSet, value);
+		return true;
+	}
 
+	// this is the diff set -> difficulties
+	template<typename ValueT>
+	static bool ReadDetailsSetDifficultyBeatmapsV3(DetailsSet& detailsSet, ValueT const& value) {
+		if (!value.IsArray()) return false;
 		// check each beatmap
-		for (auto& beatmap : difficultyBeatmapsItr->value.GetArray()) {
-			auto diffName = utf8::utf16to8(beatmap[u"_difficulty"].Get<std::u16string>());
+		for (auto& beatmap : value.GetArray()) {
+			auto diffName = GetUTF8String(beatmap[KEY("_difficulty")]);
 			GlobalNamespace::BeatmapDifficulty diff = ParseDiff(diffName);
 
-			auto& diffData = difficultyToDifficultyBeatmapDetails[diff];
-			diffData.characteristicName = characteristicName;
+			auto& diffData = detailsSet.difficultyToDifficultyBeatmapDetails[diff];
+			diffData.characteristicName = detailsSet.characteristicName;
 			diffData.difficulty = diff;
 			diffData.DeserializeV3(beatmap);
 		}
-
 		return true;
 	}
 
-	bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetailsSet::DeserializeV4(ValueUTF16 const& value) {
-		auto memberEnd = value.MemberEnd();
+	template<typename ValueT>
+	static constexpr auto DetailsSetFieldsV3 = Utils::MakeFieldTable<DetailsSet, ValueT>({
+		{ "_customData", &ReadDetailsSetCustomDataV3<ValueT> },
+		{ "_difficultyBeatmaps", &ReadDetailsSetDifficultyBeatmapsV3<ValueT> },
+	});
 
-		auto characteristicLabelItr = value.FindMember(u"label");
-		if (characteristicLabelItr != memberEnd) characteristicLabel = utf8::utf16to8(characteristicLabelItr->value.Get<std::u16string>());
+	template<typename ValueT>
+	static constexpr auto DetailsSetFieldsV4 = Utils::MakeFieldTable<DetailsSet, ValueT>({
+		{ "label", &ReadStringField<&DetailsSet::characteristicLabel, ValueT> },
+		{ "iconPath", &ReadStringField<&DetailsSet::characteristicIconImageFileName, ValueT> },
+	});
 
-		auto iconPathItr = value.FindMember(u"iconPath");
-		if (iconPathItr != memberEnd) characteristicIconImageFileName = utf8::utf16to8(iconPathItr->value.Get<std::u16string>());
+	bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetailsSet::Deserialize(ValueUTF16 const& value) {
+		return DeserializeV3(value);
+	}
+
+	bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetailsSet::DeserializeV3(ValueUTF16 const& value) {
+		return DetailsSetFieldsV3<ValueUTF16>.Read(*this, value) & DetailsSetFieldsV3<ValueUTF16>.Bit("_difficultyBeatmaps");
+	}
+
+	bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetailsSet::DeserializeV3(ValueUTF8 const& value) {
+		return DetailsSetFieldsV3<ValueUTF8>.Read(*this, value) & DetailsSetFieldsV3<ValueUTF8>.Bit("_difficultyBeatmaps");
+	}
 
+	bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetailsSet::DeserializeV4(ValueUTF16 const& value) {
+		DetailsSetFieldsV4<ValueUTF16>.Read(*this, value);
 		return true;
 	}
 
-	static void ParseSimpleStringArrayInto(ValueUTF16 const& customData, std::u16string_view valueName, std::vector<std::string>& out) {
-		auto arrayItr = customData.FindMember(valueName.data());
-		if (arrayItr == customData.MemberEnd() || !arrayItr->value.IsArray()) return;
-		for (auto& value : arrayItr->value.GetArray()) {
-			out.emplace_back(utf8::utf16to8(value.Get<std::u16string>()));
-		}
+	bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetailsSet::DeserializeV4(ValueUTF8 const& value) {
+		DetailsSetFieldsV4<ValueUTF8>.Read(*this, value);
+		return true;
+	}
+
+	/// @brief reads a color straight into the custom colors of the difficulty, so colors don't take a second pass over the custom data
+	template<CustomColors::Slot Slot, typename ValueT>
+	static bool ReadDifficultyColorSlot(DifficultyDetails& details, ValueT const& value) {
+		if (!value.IsObject()) return false;
+		if (!details.customColors) details.customColors.emplace();
+		details.customColors->Set(Slot, DeserializeColor(value));
+		return true;
 	}
 
 	// this is each difficulty individually
+	template<typename ValueT>
+	static constexpr auto DifficultyCustomDataFieldsV3 = Utils::MakeFieldTable<DifficultyDetails, ValueT>({
+		{ "_difficultyLabel", &ReadStringField<&DifficultyDetails::customDiffLabel, ValueT> },
+		{ "_environmentType", &ReadStringField<&DifficultyDetails::environmentType, ValueT> },
+		{ "_showRotationNoteSpawnLines", &ReadBoolField<&DifficultyDetails::showRotationNoteSpawnLines, ValueT> },
+		{ "_oneSaber", &ReadBoolField<&DifficultyDetails::oneSaber, ValueT> },
+		{ "_requirements", &ReadInternedArrayField<&DifficultyDetails::requirements, ValueT> },
+		{ "_suggestions", &ReadInternedArrayField<&DifficultyDetails::suggestions, ValueT> },
+		{ "_warnings", &ReadInternedArrayField<&DifficultyDetails::warnings, ValueT> },
+		{ "_information", &ReadInternedArrayField<&DifficultyDetails::information, ValueT> },
+		{ "_colorLeft", &ReadDifficultyColorSlot<CustomColors::ColorLeft, ValueT> },
+		{ "_colorRight", &ReadDifficultyColorSlot<CustomColors::ColorRight, ValueT> },
+		{ "_envColorRight", &ReadDifficultyColorSlot<CustomColors::EnvColorRight, ValueT> },
+		{ "_envColorLeft", &ReadDifficultyColorSlot<CustomColors::EnvColorLeft, ValueT> },
+		{ "_envColorWhite", &ReadDifficultyColorSlot<CustomColors::EnvColorWhite, ValueT> },
+		{ "_envColorLeftBoost", &ReadDifficultyColorSlot<CustomColors::EnvColorLeftBoost, ValueT> },
+		{ "_envColorRightBoost", &ReadDifficultyColorSlot<CustomColors::EnvColorRightBoost, ValueT> },
+		{ "_envColorWhiteBoost", &ReadDifficultyColorSlot<CustomColors::EnvColorWhiteBoost, ValueT> },
+		{ "_obstacleColor", &ReadDifficultyColorSlot<CustomColors::ObstacleColor, ValueT> },
+	});
+
+	template<typename ValueT>
+	static constexpr auto DifficultyCustomDataFieldsV4 = Utils::MakeFieldTable<DifficultyDetails, ValueT>({
+		{ "difficultyLabel", &ReadStringField<&DifficultyDetails::customDiffLabel, ValueT> },
+		{ "environmentType", &ReadStringField<&DifficultyDetails::environmentType, ValueT> },
+		{ "showRotationNoteSpawnLines", &ReadBoolField<&DifficultyDetails::showRotationNoteSpawnLines, ValueT> },
+		{ "oneSaber", &ReadBoolField<&DifficultyDetails::oneSaber, ValueT> },
+		{ "requirements", &ReadInternedArrayField<&DifficultyDetails::requirements, ValueT> },
+		{ "suggestions", &ReadInternedArrayField<&DifficultyDetails::suggestions, ValueT> },
+		{ "warnings", &ReadInternedArrayField<&DifficultyDetails::warnings, ValueT> },
+		{ "information", &ReadInternedArrayField<&DifficultyDetails::information, ValueT> },
+		{ "colorLeft", &ReadDifficultyColorSlot<CustomColors::ColorLeft, ValueT> },
+		{ "colorRight", &ReadDifficultyColorSlot<CustomColors::ColorRight, ValueT> },
+		{ "envColorRight", &ReadDifficultyColorSlot<CustomColors::EnvColorRight, ValueT> },
+		{ "envColorLeft", &ReadDifficultyColorSlot<CustomColors::EnvColorLeft, ValueT> },
+		{ "envColorWhite", &ReadDifficultyColorSlot<CustomColors::EnvColorWhite, ValueT> },
+		{ "envColorLeftBoost", &ReadDifficultyColorSlot<CustomColors::EnvColorLeftBoost, ValueT> },
+		{ "envColorRightBoost", &ReadDifficultyColorSlot<CustomColors::EnvColorRightBoost, ValueT> },
+		{ "envColorWhiteBoost", &ReadDifficultyColorSlot<CustomColors::EnvColorWhiteBoost, ValueT> },
+		{ "obstacleColor", &ReadDifficultyColorSlot<CustomColors::ObstacleColor, ValueT> },
+	});
+
+	template<typename ValueT>
+	static bool DeserializeDifficultyDetailsV3(DifficultyDetails& details, ValueT const& value) {
+		auto customDataItr = value.FindMember(KEY("_customData"));
+		if (customDataItr == value.MemberEnd()) return false;
+		DifficultyCustomDataFieldsV3<ValueT>.Read(details, customDataItr->value);
+		return true;
+	}
+
+	template<typename ValueT>
+	static bool DeserializeDifficultyDetailsV4(DifficultyDetails& details, ValueT const& value) {
+		auto customDataItr = value.FindMember(KEY("customData"));
+		if (customDataItr == value.MemberEnd()) return false;
+		DifficultyCustomDataFieldsV4<ValueT>.Read(details, customDataItr->value);
+		return true;
+	}
+
 	bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails::Deserialize(ValueUTF16 const& value) {
 		return DeserializeV3(value);
 	}
 
 	bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails::DeserializeV3(ValueUTF16 const& value) {
-		auto customDataItr = value.FindMember(u"_customData");
-		if (customDataItr == value.MemberEnd()) return false;
-		auto& customData = customDataItr->value;
-		auto memberEnd = customData.MemberEnd();
+		return DeserializeDifficultyDetailsV3(*this, value);
+	}
+
+	bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails::DeserializeV3(ValueUTF8 const& value) {
+		return DeserializeDifficultyDetailsV3(*this, value);
+	}
 
-		auto difficultyLabelItr = customData.FindMember(u"_difficultyLabel");
-		if (difficultyLabelItr != memberEnd) customDiffLabel = utf8::utf16to8(difficultyLabelItr->value.Get<std::u16string>());
+	bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails::DeserializeV4(ValueUTF16 const& value) {
+		return DeserializeDifficultyDetailsV4(*this, value);
+	}
+
+	bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails::DeserializeV4(ValueUTF8 const& value) {
+		return DeserializeDifficultyDetailsV4(*this, value);
+	}
+
+	template<typename ValueT>
+	static constexpr auto CustomColorFieldsV3 = Utils::MakeFieldTable<CustomColors, ValueT>({
+		{ "_colorLeft", &ReadColorSlot<CustomColors::ColorLeft, ValueT> },
+		{ "_colorRight", &ReadColorSlot<CustomColors::ColorRight, ValueT> },
+		{ "_envColorRight", &ReadColorSlot<CustomColors::EnvColorRight, ValueT> },
+		{ "_envColorLeft", &ReadColorSlot<CustomColors::EnvColorLeft, ValueT> },
+		{ "_envColorWhite", &ReadColorSlot<CustomColors::EnvColorWhite, ValueT> },
+		{ "_envColorLeftBoost", &ReadColorSlot<CustomColors::EnvColorLeftBoost, ValueT> },
+		{ "_envColorRightBoost", &ReadColorSlot<CustomColors::EnvColorRightBoost, ValueT> },
+		{ "_envColorWhiteBoost", &ReadColorSlot<CustomColors::EnvColorWhiteBoost, ValueT> },
+		{ "_obstacleColor", &ReadColorSlot<CustomColors::ObstacleColor, ValueT> },
+	});
+
+	template<typename ValueT>
+	static constexpr auto CustomColorFieldsV4 = Utils::MakeFieldTable<CustomColors, ValueT>({
+		{ "colorLeft", &ReadColorSlot<CustomColors::ColorLeft, ValueT> },
+		{ "colorRight", &ReadColorSlot<CustomColors::ColorRight, ValueT> },
+		{ "envColorRight", &ReadColorSlot<CustomColors::EnvColorRight, ValueT> },
+		{ "envColorLeft", &ReadColorSlot<CustomColors::EnvColorLeft, ValueT> },
+		{ "envColorWhite", &ReadColorSlot<CustomColors::EnvColorWhite, ValueT> },
+		{ "envColorLeftBoost", &ReadColorSlot<CustomColors::EnvColorLeftBoost, ValueT> },
+		{ "envColorRightBoost", &ReadColorSlot<CustomColors::EnvColorRightBoost, ValueT> },
+		{ "envColorWhiteBoost", &ReadColorSlot<CustomColors::EnvColorWhiteBoost, ValueT> },
+		{ "obstacleColor", &ReadColorSlot<CustomColors::ObstacleColor, ValueT> },
+	});
 
-		auto environmentTypeItr = customData.FindMember(u"_environmentType");
-		if (environmentTypeItr != memberEnd) environmentType = utf8::utf16to8(environmentTypeItr->value.Get<std::u16string>());
+    bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails::CustomColors::Deserialize(ValueUTF16 const& value) {
+		return DeserializeV3(value);
+	}
 
-		auto showRotationNoteSpawnLinesItr = customData.FindMember(u"_showRotationNoteSpawnLines");
-		if (showRotationNoteSpawnLinesItr != memberEnd) showRotationNoteSpawnLines = showRotationNoteSpawnLinesItr->value.GetBool();
+    bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails::CustomColors::DeserializeV3(ValueUTF16 const& value) {
+		return CustomColorFieldsV3<ValueUTF16>.Read(*this, value) != 0;
+	}
 
-		auto oneSaberItr = customData.FindMember(u"_oneSaber");
-		if (oneSaberItr != memberEnd) oneSaber = oneSaberItr->value.GetBool();
+    bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails::CustomColors::DeserializeV3(ValueUTF8 const& value) {
+		return CustomColorFieldsV3<ValueUTF8>.Read(*this, value) != 0;
+	}
 
-		ParseSimpleStringArrayInto(customData, u"_requirements", requirements);
-		ParseSimpleStringArrayInto(customData, u"_suggestions", suggestions);
-		ParseSimpleStringArrayInto(customData, u"_warnings", warnings);
-		ParseSimpleStringArrayInto(customData, u"_information", information);
+    bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails::CustomColors::DeserializeV4(ValueUTF16 const& value) {
+		return CustomColorFieldsV4<ValueUTF16>.Read(*this, value) != 0;
+	}
+
+    bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails::CustomColors::DeserializeV4(ValueUTF8 const& value) {
+		return CustomColorFieldsV4<ValueUTF8>.Read(*this, value) != 0;
+	}
 
-		CustomColors customColors;
-		// if any custom colors are deserialized, set the value
-		if (customColors.DeserializeV3(customData)) this->customColors = std::move(customColors);
+	#undef KEY
 
-		return true;
+	/// @brief transcodes a utf8 value into its own utf16 document
+	static void ConvertToUTF16(ValueUTF8 const& value, DocumentUTF16& out) {
+		rapidjson::GenericStringBuffer<rapidjson::UTF16<char16_t>> buffer;
+		rapidjson::Writer<rapidjson::GenericStringBuffer<rapidjson::UTF16<char16_t>>, rapidjson::UTF8<char>, rapidjson::UTF16<char16_t>> writer(buffer);
+		value.Accept(writer);
+		out.Parse(buffer.GetString());
 	}
 
-	bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails::DeserializeV4(ValueUTF16 const& value) {
-		auto customDataItr = value.FindMember(u"customData");
-		if (customDataItr == value.MemberEnd()) return false;
-		auto& customData = customDataItr->value;
-		auto memberEnd = customData.MemberEnd();
+	/// @brief amount of released documents that stay cached after being reparsed
+	static constexpr size_t ReparseCacheSize = 8;
+	static std::mutex _reparseCacheMutex;
+	/// @brief most recently used first
+	static std::list<std::pair<std::filesystem::path, std::shared_ptr<DocumentUTF8 const>>> _reparseCache;
+
+	static std::shared_ptr<DocumentUTF8 const> GetReparsedDocument(std::filesystem::path const& path) {
+		{
+			std::lock_guard<std::mutex> lock(_reparseCacheMutex);
+			auto itr = std::find_if(_reparseCache.begin(), _reparseCache.end(), [&path](auto const& entry) { return entry.first == path; });
+			if (itr != _reparseCache.end()) {
+				_reparseCache.splice(_reparseCache.begin(), _reparseCache, itr);
+				return itr->second;
+			}
+		}
+
+		auto text = Utils::ReadUTF8Text(path);
+		std::shared_ptr<DocumentUTF8 const> document = Utils::ParseCompactDocumentInsitu(text, "reparsing released info.dat");
+		if (!document) return nullptr;
 
-		auto difficultyLabelItr = customData.FindMember(u"difficultyLabel");
-		if (difficultyLabelItr != memberEnd) customDiffLabel = utf8::utf16to8(difficultyLabelItr->value.Get<std::u16string>());
+		std::lock_guard<std::mutex> lock(_reparseCacheMutex);
+		_reparseCache.emplace_front(path, document);
+		if (_reparseCache.size() > ReparseCacheSize) _reparseCache.pop_back();
+		return document;
+	}
 
-		auto environmentTypeItr = customData.FindMember(u"environmentType");
-		if (environmentTypeItr != memberEnd) environmentType = utf8::utf16to8(environmentTypeItr->value.Get<std::u16string>());
+	InfoDocument::InfoDocument(std::filesystem::path path, std::shared_ptr<DocumentUTF8 const> document) : _path(std::move(path)), _retained(std::move(document)) {}
 
-		auto showRotationNoteSpawnLinesItr = customData.FindMember(u"showRotationNoteSpawnLines");
-		if (showRotationNoteSpawnLinesItr != memberEnd) showRotationNoteSpawnLines = showRotationNoteSpawnLinesItr->value.GetBool();
+	std::shared_ptr<DocumentUTF8 const> InfoDocument::Get() const {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (_retained) return _retained;
+		}
+		if (_path.empty()) return nullptr;
+		return GetReparsedDocument(_path);
+	}
 
-		auto oneSaberItr = customData.FindMember(u"oneSaber");
-		if (oneSaberItr != memberEnd) oneSaber = oneSaberItr->value.GetBool();
+	std::shared_ptr<DocumentUTF16> InfoDocument::GetUTF16(std::string const& pointer) const {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			auto itr = _utf16Copies.find(pointer);
+			if (itr != _utf16Copies.end()) return itr->second;
+		}
 
-		ParseSimpleStringArrayInto(customData, u"requirements", requirements);
-		ParseSimpleStringArrayInto(customData, u"suggestions", suggestions);
-		ParseSimpleStringArrayInto(customData, u"warnings", warnings);
-		ParseSimpleStringArrayInto(customData, u"information", information);
+		auto document = Get();
+		if (!document) return nullptr;
+		auto value = pointer.empty() ? document.get() : rapidjson::GenericPointer<ValueUTF8>(pointer.c_str()).Get(*document);
+		if (!value) return nullptr;
 
-		CustomColors customColors;
-		// if any custom colors are deserialized, set the value
-		if (customColors.DeserializeV4(customData)) this->customColors = std::move(customColors);
+		auto copy = std::make_shared<DocumentUTF16>();
+		ConvertToUTF16(*value, *copy);
 
-		return true;
+		// a released document is reparsed for every access, caching its copies would keep the data around anyway
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (!_retained) return copy;
+		return _utf16Copies.try_emplace(pointer, std::move(copy)).first->second;
 	}
 
-	static UnityEngine::Color DeserializeColor(ValueUTF16 const& value) {
-		auto memberEnd = value.MemberEnd();
-		float r = 1.0f, g = 1.0f, b = 1.0f, a = 1.0f;
-		auto rItr = value.FindMember(u"r");
-		if (rItr != memberEnd && rItr->value.IsNumber()) r = rItr->value.GetFloat();
-		auto gItr = value.FindMember(u"g");
-		if (gItr != memberEnd && gItr->value.IsNumber()) g = gItr->value.GetFloat();
-		auto bItr = value.FindMember(u"b");
-		if (bItr != memberEnd && bItr->value.IsNumber()) b = bItr->value.GetFloat();
-		auto aItr = value.FindMember(u"a");
-		if (aItr != memberEnd && aItr->value.IsNumber()) a = aItr->value.GetFloat();
+	void InfoDocument::Release() {
+		if (_path.empty()) return;
+		std::lock_guard<std::mutex> lock(_mutex);
+		_retained.reset();
+		_utf16Copies.clear();
+	}
 
-		return {r, g, b, a};
+	bool InfoDocument::get_isRetained() const {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _retained != nullptr;
 	}
 
-	#define DESERIALIZE_OPT_COLOR(prefix, color_) do {					\
-		auto itr = value.FindMember(prefix u## #color_);				\
-		if (itr != memberEnd && itr->value.IsObject()) {                \
-			color_ = DeserializeColor(itr->value);                      \
-			foundAnything = true;                                       \
-		}                                                               \
-	} while (0)
+	DocumentValueRef::DocumentValueRef(std::shared_ptr<InfoDocument const> document, std::string pointer) : _document(std::move(document)), _pointer(std::move(pointer)), _pins(std::make_shared<Pins>()) {}
 
-    bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails::CustomColors::Deserialize(ValueUTF16 const& value) {
-		return DeserializeV3(value);
+	std::shared_ptr<const ValueUTF8> DocumentValueRef::Get() const {
+		if (!_document) return nullptr;
+		auto document = _document->Get();
+		if (!document) return nullptr;
+		if (_pointer.empty()) return document;
+
+		auto value = rapidjson::GenericPointer<ValueUTF8>(_pointer.c_str()).Get(*document);
+		if (!value) return nullptr;
+		// alias the document so the value keeps it alive
+		return std::shared_ptr<const ValueUTF8>(std::move(document), value);
 	}
 
-    bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails::CustomColors::DeserializeV3(ValueUTF16 const& value) {
-		auto memberEnd = value.MemberEnd();
-		bool foundAnything = false;
-		DESERIALIZE_OPT_COLOR(u"_", colorLeft);
-		DESERIALIZE_OPT_COLOR(u"_", colorRight);
-		DESERIALIZE_OPT_COLOR(u"_", envColorRight);
-		DESERIALIZE_OPT_COLOR(u"_", envColorLeft);
-		DESERIALIZE_OPT_COLOR(u"_", envColorWhite);
-		DESERIALIZE_OPT_COLOR(u"_", envColorLeftBoost);
-		DESERIALIZE_OPT_COLOR(u"_", envColorRightBoost);
-		DESERIALIZE_OPT_COLOR(u"_", envColorWhiteBoost);
-		DESERIALIZE_OPT_COLOR(u"_", obstacleColor);
+	std::shared_ptr<DocumentUTF16> DocumentValueRef::GetUTF16Document() const {
+		if (!_document) return nullptr;
+		return _document->GetUTF16(_pointer);
+	}
 
-		return foundAnything;
+	std::shared_ptr<const ValueUTF16> DocumentValueRef::GetUTF16() const {
+		return GetUTF16Document();
 	}
 
-    bool CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails::CustomColors::DeserializeV4(ValueUTF16 const& value) {
-		auto memberEnd = value.MemberEnd();
-		bool foundAnything = false;
-		DESERIALIZE_OPT_COLOR(u"", colorLeft);
-		DESERIALIZE_OPT_COLOR(u"", colorRight);
-		DESERIALIZE_OPT_COLOR(u"", envColorRight);
-		DESERIALIZE_OPT_COLOR(u"", envColorLeft);
-		DESERIALIZE_OPT_COLOR(u"", envColorWhite);
-		DESERIALIZE_OPT_COLOR(u"", envColorLeftBoost);
-		DESERIALIZE_OPT_COLOR(u"", envColorRightBoost);
-		DESERIALIZE_OPT_COLOR(u"", envColorWhiteBoost);
-		DESERIALIZE_OPT_COLOR(u"", obstacleColor);
-
-		return foundAnything;
+	std::optional<std::reference_wrapper<const ValueUTF8>> DocumentValueRef::GetPinned() const {
+		if (!_pins) return std::nullopt;
+		std::lock_guard<std::mutex> lock(_pins->mutex);
+		if (!_pins->utf8) _pins->utf8 = Get();
+		if (!_pins->utf8) return std::nullopt;
+		return std::cref(*_pins->utf8);
+	}
+
+	std::optional<std::reference_wrapper<const ValueUTF16>> DocumentValueRef::GetPinnedUTF16() const {
+		if (!_pins) return std::nullopt;
+		std::lock_guard<std::mutex> lock(_pins->mutex);
+		if (!_pins->utf16) _pins->utf16 = GetUTF16();
+		if (!_pins->utf16) return std::nullopt;
+		return std::cref(*_pins->utf16);
+	}
+
+	std::shared_ptr<DocumentUTF8 const> CustomSaveDataInfo::get_docUTF8() const {
+		if (!_document) return nullptr;
+		return _document->Get();
+	}
+
+	std::optional<std::reference_wrapper<const ValueUTF8>> CustomSaveDataInfo::get_customDataUTF8() const {
+		return _customData.GetPinned();
+	}
+
+	std::shared_ptr<const ValueUTF8> CustomSaveDataInfo::get_sharedCustomDataUTF8() const {
+		return _customData.Get();
+	}
+
+	std::shared_ptr<DocumentUTF16> CustomSaveDataInfo::get_doc() const {
+		return _docUTF16.GetUTF16Document();
+	}
+
+	std::optional<std::reference_wrapper<const ValueUTF16>> CustomSaveDataInfo::get_customData() const {
+		return _customData.GetPinnedUTF16();
+	}
+
+	std::shared_ptr<const ValueUTF16> CustomSaveDataInfo::get_sharedCustomData() const {
+		return _customData.GetUTF16();
+	}
+
+	void CustomSaveDataInfo::SetDocument(std::filesystem::path infoPath, std::shared_ptr<DocumentUTF8 const> document) {
+		_document = std::make_shared<InfoDocument>(std::move(infoPath), std::move(document));
+		_docUTF16 = DocumentValueRef(_document, "");
+		// saveDataVersion is set before the document, so the custom data key is known here
+		_customData = DocumentValueRef(_document, saveDataVersion == SaveDataVersion::V4 ? "/customData" : "/_customData");
+	}
+
+	void CustomSaveDataInfo::ReleaseDocument() {
+		if (!_document) return;
+		// everything the game and songcore itself need is in the details, so extract them before dropping the document
+		ParseLevelDetails();
+		_document->Release();
 	}
 
 void CustomDifficultyBeatmapSet::ctor(
@@ -121,7 +121,7 @@ void SetCustomCharacteristicLabels(GlobalNamespace::BeatmapCharacteristicSegment
         }
         auto& characteristicDetails = characteristicDetailsOpt->get();
 
-        auto label = characteristicDetails.characteristicLabel.value_or(characteristicDetails.characteristicName);
+        auto label = characteristicDetails.characteristicLabel.value_or(characteristicDetails.characteristicName.str());
         UnityEngine::Sprite* icon = characteristicInfo.icon.unchecked_ptr();
         if (characteristicDetails.characteristicIconImageFileName.has_value() && !characteristicDetails.characteristicIconImageFileName->empty()) {
             auto iconCache = SongCore::UI::IconCache::get_instance();
@@ -231,6 +231,7 @@ GlobalNamespace::ColorScheme* GetOverrideColorScheme(GlobalNamespace::ColorSchem
 
     if (!diffDetails.customColors.has_value()) return nullptr;
     auto& customColors = diffDetails.customColors.value();
+    using CustomColors = SongCore::CustomJSONData::CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails::CustomColors;
 
     // we just grab all colors by default
     UnityEngine::Color saberAColor = baseColorScheme->saberAColor;
@@ -244,25 +245,25 @@ GlobalNamespace::ColorScheme* GetOverrideColorScheme(GlobalNamespace::ColorSchem
     UnityEngine::Color obstaclesColor = baseColorScheme->obstaclesColor;
 
     if (config.customSongObstacleColors) {
-        obstaclesColor = customColors.obstacleColor.value_or(obstaclesColor);
+        obstaclesColor = customColors.Get(CustomColors::ObstacleColor, obstaclesColor);
     }
 
     if (config.customSongNoteColors) {
-        saberAColor = customColors.colorLeft.value_or(saberAColor);
-        saberBColor = customColors.colorRight.value_or(saberBColor);
+        saberAColor = customColors.Get(CustomColors::ColorLeft, saberAColor);
+        saberBColor = customColors.Get(CustomColors::ColorRight, saberBColor);
     }
 
     // environment colors fall back to the map's note colors before falling back to the base scheme
-    environmentColor0 = customColors.colorLeft.value_or(environmentColor0);
-    environmentColor1 = customColors.colorRight.value_or(environmentColor1);
+    environmentColor0 = customColors.Get(CustomColors::ColorLeft, environmentColor0);
+    environmentColor1 = customColors.Get(CustomColors::ColorRight, environmentColor1);
 
     if (config.customSongEnvironmentColors) {
-        environmentColor0 = customColors.envColorLeft.value_or(environmentColor0);
-        environmentColor1 = customColors.envColorRight.value_or(environmentColor1);
-        environmentColorW = customColors.envColorWhite.value_or(environmentColorW);
-        environmentColor0Boost = customColors.envColorLeftBoost.value_or(environmentColor0Boost);
-        environmentColor1Boost = customColors.envColorRightBoost.value_or(environmentColor1Boost);
-        environmentColorWBoost = customColors.envColorWhiteBoost.value_or(environmentColorWBoost);
+        environmentColor0 = customColors.Get(CustomColors::EnvColorLeft, environmentColor0);
+        environmentColor1 = customColors.Get(CustomColors::EnvColorRight, environmentColor1);
+        environmentColorW = customColors.Get(CustomColors::EnvColorWhite, environmentColorW);
+        environmentColor0Boost = customColors.Get(CustomColors::EnvColorLeftBoost, environmentColor0Boost);
+        environmentColor1Boost = customColors.Get(CustomColors::EnvColorRightBoost, environmentColor1Boost);
+        environmentColorWBoost = customColors.Get(CustomColors::EnvColorWhiteBoost, environmentColorWBoost);
     }
 
     UnityEngine::Color const defaultColor{};
@@ -154,8 +154,6 @@ MAKE_AUTO_ORIG_HOOK_MATCH(BeatmapLevelsModel_CreateAllLoadedBeatmapLevelPacks, &
         custom->AddLevelPack(levelPacks[i]);
     }
 
-    custom->FixBackingDictionaries();
-
     self->_allLoadedBeatmapLevelsRepository = custom;
 }
 
@@ -190,13 +188,15 @@ MAKE_AUTO_ORIG_HOOK_MATCH(BeatmapLevelsModel_ReloadCustomLevelPackCollectionAsyn
         return Task_1<GlobalNamespace::BeatmapLevelsRepository*>::FromResult(static_cast<GlobalNamespace::BeatmapLevelsRepository*>(SongCore::API::Loading::GetCustomBeatmapLevelsRepository()));
     }
 
-    // levels weren't loaded or we are refreshing right now, so make the user wait
-    return SongCore::StartTask<GlobalNamespace::BeatmapLevelsRepository*>([](SongCore::CancellationToken cancelToken) -> GlobalNamespace::BeatmapLevelsRepository* {
-        using namespace std::chrono_literals;
-        auto loader = SongCore::SongLoader::RuntimeSongLoader::get_instance();
-        while (loader->AreSongsRefreshing && !cancelToken.IsCancellationRequested) std::this_thread::sleep_for(100ms);
-        return loader->CustomBeatmapLevelsRepository;
-    }, std::forward<SongCore::CancellationToken>(cancellationToken));
+    // levels weren't loaded or we are refreshing right now, so make the user wait until the loader says it's done
+    auto task = Task_1<GlobalNamespace::BeatmapLevelsRepository*>::New_ctor();
+    auto registration = SongCore::CancelTaskOnToken(task, cancellationToken);
+    auto loader = SongCore::SongLoader::RuntimeSongLoader::get_instance();
+    loader->OnRefreshCompleted([task, registration, loader]() mutable {
+        if (registration) registration->Dispose();
+        task->TrySetResult(static_cast<GlobalNamespace::BeatmapLevelsRepository*>(loader->CustomBeatmapLevelsRepository));
+    });
+    return task;
 }
 
 // gets the char16 representation of the 2 nibbles that fit 1 char
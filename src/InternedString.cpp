@@ -0,0 +1,114 @@
+#include "InternedString.hpp"
+
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace SongCore {
+    /// @brief entries are stored in fixed size pages that never move, so views can be read without taking the lock
+    static constexpr size_t PageSize = 4096;
+    static constexpr size_t MaxPages = 4096;
+    /// @brief string data is bump allocated from chunks of this size, bigger strings get their own allocation
+    static constexpr size_t ChunkSize = 64 * 1024;
+
+    using Page = std::array<std::string_view, PageSize>;
+
+    static std::shared_mutex _poolMutex;
+    static std::unordered_map<std::string_view, uint32_t> _poolIds;
+    static std::array<std::atomic<Page*>, MaxPages> _pages;
+    static std::vector<std::unique_ptr<Page>> _ownedPages;
+    static std::vector<std::unique_ptr<char[]>> _chunks;
+    static size_t _chunkUsed = ChunkSize;
+    static size_t _poolBytes = 0;
+    static uint32_t _nextId = 1;
+
+    /// @brief copies the string into the arena, null terminated. expects the pool to be locked exclusively
+    static std::string_view AllocateString(std::string_view str) {
+        auto size = str.size() + 1;
+        char* data;
+        if (size > ChunkSize / 4) {
+            data = _chunks.emplace_back(std::make_unique<char[]>(size)).get();
+            // keep bump allocating from the previous chunk
+            if (_chunks.size() > 1) std::swap(_chunks[_chunks.size() - 1], _chunks[_chunks.size() - 2]);
+            _poolBytes += size;
+        } else {
+            if (_chunkUsed + size > ChunkSize) {
+                _chunks.emplace_back(std::make_unique<char[]>(ChunkSize));
+                _chunkUsed = 0;
+                _poolBytes += ChunkSize;
+            }
+            data = _chunks.back().get() + _chunkUsed;
+            _chunkUsed += size;
+        }
+
+        std::copy(str.begin(), str.end(), data);
+        data[str.size()] = '\0';
+        return { data, str.size() };
+    }
+
+    InternedString::InternedString(std::string_view str) {
+        if (str.empty()) return;
+
+        {
+            std::shared_lock<std::shared_mutex> lock(_poolMutex);
+            auto itr = _poolIds.find(str);
+            if (itr != _poolIds.end()) {
+                _id = itr->second;
+                return;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(_poolMutex);
+        // another thread may have interned it in between the locks
+        auto itr = _poolIds.find(str);
+        if (itr != _poolIds.end()) {
+            _id = itr->second;
+            return;
+        }
+
+        auto pageIdx = _nextId / PageSize;
+        if (pageIdx >= MaxPages) throw std::length_error("Interned string pool is full");
+        auto page = _pages[pageIdx].load(std::memory_order_relaxed);
+        if (!page) {
+            page = _ownedPages.emplace_back(std::make_unique<Page>()).get();
+            _pages[pageIdx].store(page, std::memory_order_release);
+        }
+
+        auto stored = AllocateString(str);
+        (*page)[_nextId % PageSize] = stored;
+        _poolIds.emplace(stored, _nextId);
+        _id = _nextId++;
+    }
+
+    std::optional<InternedString> InternedString::Find(std::string_view str) {
+        if (str.empty()) return InternedString();
+
+        std::shared_lock<std::shared_mutex> lock(_poolMutex);
+        auto itr = _poolIds.find(str);
+        if (itr == _poolIds.end()) return std::nullopt;
+        return InternedString(itr->second);
+    }
+
+    size_t InternedString::GetPoolCount() {
+        std::shared_lock<std::shared_mutex> lock(_poolMutex);
+        return _poolIds.size();
+    }
+
+    size_t InternedString::GetPoolBytes() {
+        std::shared_lock<std::shared_mutex> lock(_poolMutex);
+        return _poolBytes;
+    }
+
+    std::string_view InternedString::view() const {
+        if (_id == 0) return "";
+        // a handle can only exist after its entry was written, so the page is always there
+        auto page = _pages[_id / PageSize].load(std::memory_order_acquire);
+        return (*page)[_id % PageSize];
+    }
+}
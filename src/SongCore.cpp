@@ -2,6 +2,7 @@
 #include "SongLoader/RuntimeSongLoader.hpp"
 #include "logging.hpp"
 #include "config.hpp"
+#include "Utils/SortKey.hpp"
 
 #include "UnityEngine/HideFlags.hpp"
 #include "UnityEngine/Sprite.hpp"
@@ -13,6 +14,11 @@
 
 #include "beatsaber-hook/shared/safeptr.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <optional>
 #include <unordered_map>
 
 static inline UnityEngine::HideFlags operator |(UnityEngine::HideFlags a, UnityEngine::HideFlags b) {
@@ -22,31 +28,76 @@ static inline UnityEngine::HideFlags operator |(UnityEngine::HideFlags a, UnityE
 namespace SongCore::API {
     namespace Capabilities {
         static unordered_event_callback<std::string_view, Capabilities::CapabilityEventKind> _capabilitiesUpdated;
-        std::mutex _registeredCapabilitiesMutex;
-        static std::vector<std::string> _registeredCapabilities;
+        /// @brief immutable set of registered capabilities. a new snapshot gets published for every change, so readers never have to lock
+        struct CapabilitySnapshot {
+            std::vector<std::string> capabilities;
+            /// @brief open addressing table of index + 1 into capabilities, 0 is an empty slot. size is a power of 2
+            std::vector<uint32_t> slots;
+            /// @brief same capabilities as interned requirement ids
+            SongLoader::RequirementMask mask;
+
+            CapabilitySnapshot() : slots(1) {}
+
+            CapabilitySnapshot(std::vector<std::string> caps) : capabilities(std::move(caps)) {
+                size_t slotCount = 1;
+                while (slotCount < capabilities.size() * 2) slotCount <<= 1;
+                slots.resize(slotCount);
+                for (size_t i = 0; i < capabilities.size(); i++) {
+                    auto slot = std::hash<std::string_view>()(capabilities[i]) & (slotCount - 1);
+                    while (slots[slot]) slot = (slot + 1) & (slotCount - 1);
+                    slots[slot] = i + 1;
+                    mask.Set(capabilities[i]);
+                }
+            }
+
+            bool Contains(std::string_view sanitized) const {
+                auto slotMask = slots.size() - 1;
+                for (auto slot = std::hash<std::string_view>()(sanitized) & slotMask; slots[slot]; slot = (slot + 1) & slotMask) {
+                    if (capabilities[slots[slot] - 1] == sanitized) return true;
+                }
+                return false;
+            }
+        };
+
+        static std::mutex _registeredCapabilitiesMutex;
+        /// @brief current snapshot, nullptr until the first capability gets registered
+        static std::atomic<CapabilitySnapshot const*> _registeredCapabilities = nullptr;
+        /// @brief replaced snapshots are kept alive since readers may still be using them. capabilities change a handful of times per session, so this stays tiny
+        static std::vector<std::unique_ptr<CapabilitySnapshot const>> _retiredSnapshots;
+
+        static CapabilitySnapshot const& GetSnapshot() {
+            static CapabilitySnapshot const emptySnapshot;
+            auto snapshot = _registeredCapabilities.load(std::memory_order_acquire);
+            return snapshot ? *snapshot : emptySnapshot;
+        }
+
+        /// @brief publishes the new snapshot, expects _registeredCapabilitiesMutex to be held
+        static void PublishSnapshot(std::vector<std::string> capabilities) {
+            auto previous = _registeredCapabilities.exchange(new CapabilitySnapshot(std::move(capabilities)), std::memory_order_acq_rel);
+            if (previous) _retiredSnapshots.emplace_back(previous);
+        }
 
-        static std::string sanitize(std::string_view capability) {
-            std::string sanitized;
-            sanitized.reserve(capability.size());
+        /// @brief sanitizes the capability into the buffer, removing whitespace and lowercasing
+        /// @return the sanitized view, or nullopt if it didn't fit
+        static std::optional<std::string_view> SanitizeInto(std::string_view capability, std::span<char> buffer) {
+            size_t size = 0;
             for (auto c : capability) {
                 if (isspace(c)) continue;
-                sanitized.push_back(tolower(c));
+                if (size == buffer.size()) return std::nullopt;
+                buffer[size++] = tolower(c);
             }
-            return sanitized;
+            return std::string_view(buffer.data(), size);
         }
 
         void RegisterCapability(std::string_view capability) {
             std::lock_guard<std::mutex> lock(_registeredCapabilitiesMutex);
 
-            auto sanitized = sanitize(capability);
-            auto itr = std::find(
-                _registeredCapabilities.begin(),
-                _registeredCapabilities.end(),
-                sanitized
-            );
-
-            if (itr == _registeredCapabilities.end()) {
-                _registeredCapabilities.emplace_back(sanitized);
+            auto sanitized = SongLoader::RequirementMask::Sanitize(capability);
+            auto& snapshot = GetSnapshot();
+            if (!snapshot.Contains(sanitized)) {
+                auto capabilities = snapshot.capabilities;
+                capabilities.emplace_back(std::move(sanitized));
+                PublishSnapshot(std::move(capabilities));
                 _capabilitiesUpdated.invoke(capability, CapabilityEventKind::Registered);
             } else {
                 WARNING("Capability '{}' was registered more than once! not registering again", capability);
@@ -56,15 +107,12 @@ namespace SongCore::API {
         void UnregisterCapability(std::string_view capability) {
             std::lock_guard<std::mutex> lock(_registeredCapabilitiesMutex);
 
-            auto sanitized = sanitize(capability);
-            auto itr = std::find(
-                _registeredCapabilities.begin(),
-                _registeredCapabilities.end(),
-                sanitized
-            );
-
-            if (itr != _registeredCapabilities.end()) {
-                _registeredCapabilities.erase(itr);
+            auto sanitized = SongLoader::RequirementMask::Sanitize(capability);
+            auto& snapshot = GetSnapshot();
+            if (snapshot.Contains(sanitized)) {
+                auto capabilities = snapshot.capabilities;
+                std::erase(capabilities, sanitized);
+                PublishSnapshot(std::move(capabilities));
                 _capabilitiesUpdated.invoke(capability, CapabilityEventKind::Unregistered);
             } else {
                 WARNING("Capability '{}' was unregistered more than once! not unregistering again", capability);
@@ -72,26 +120,47 @@ namespace SongCore::API {
         }
 
         bool IsCapabilityRegistered(std::string_view capability) {
-            std::lock_guard<std::mutex> lock(_registeredCapabilitiesMutex);
-
-            auto sanitized = sanitize(capability);
-            auto itr = std::find(
-                _registeredCapabilities.begin(),
-                _registeredCapabilities.end(),
-                sanitized
-            );
+            std::array<char, 128> buffer;
+            if (auto sanitized = SanitizeInto(capability, buffer)) return GetSnapshot().Contains(*sanitized);
 
-            // if itr != end, that means it was found in the vector
-            return itr != _registeredCapabilities.end();
+            // very long capability, just allocate
+            return GetSnapshot().Contains(SongLoader::RequirementMask::Sanitize(capability));
         }
 
         std::span<const std::string> GetRegisteredCapabilities() {
-            return _registeredCapabilities;
+            return GetSnapshot().capabilities;
         }
 
         unordered_event_callback<std::string_view, Capabilities::CapabilityEventKind>& GetCapabilitiesUpdatedEvent() {
             return _capabilitiesUpdated;
         }
+
+        SongLoader::RequirementMask GetRegisteredCapabilityMask() {
+            return GetSnapshot().mask;
+        }
+
+        bool AreRequirementsMet(SongLoader::CustomBeatmapLevel* level, std::string_view characteristic, GlobalNamespace::BeatmapDifficulty difficulty) {
+            if (!level) return false;
+            return level->IsPlayable(characteristic, difficulty, GetRegisteredCapabilityMask());
+        }
+
+        bool IsLevelPlayable(SongLoader::CustomBeatmapLevel* level) {
+            if (!level) return false;
+            return level->IsPlayable(GetRegisteredCapabilityMask());
+        }
+
+        std::vector<SongLoader::CustomBeatmapLevel*> GetPlayableLevels() {
+            auto instance = SongLoader::RuntimeSongLoader::get_instance();
+            if (!instance) return {};
+            auto const& levelIndex = instance->LevelIndex;
+            return levelIndex.GetLevels(levelIndex.MatchPlayable(GetRegisteredCapabilityMask()));
+        }
+
+        std::vector<SongLoader::CustomBeatmapLevel*> GetLevelsUnlockedByCapability(std::string_view capability) {
+            auto instance = SongLoader::RuntimeSongLoader::get_instance();
+            if (!instance) return {};
+            return instance->LevelIndex.GetLevelsUnlockedBy(capability, GetRegisteredCapabilityMask());
+        }
     }
 
     namespace PlayButton {
@@ -278,6 +347,8 @@ namespace SongCore::API {
         static unordered_event_callback<SongCore::SongLoader::CustomBeatmapLevelsRepository*> _customLevelPacksRefreshedEvent;
         static unordered_event_callback<SongCore::SongLoader::CustomBeatmapLevel*> _songWillBeDeletedEvent;
         static unordered_event_callback<> _songDeletedEvent;
+        static unordered_event_callback<SongCore::SongLoader::CustomBeatmapLevel*> _levelAddedEvent;
+        static unordered_event_callback<SongCore::SongLoader::CustomBeatmapLevel*> _levelRemovedEvent;
 
         std::shared_future<void> RefreshSongs(bool fullRefresh) {
             auto instance = SongLoader::RuntimeSongLoader::get_instance();
@@ -285,6 +356,24 @@ namespace SongCore::API {
             return instance->RefreshSongs(fullRefresh);
         }
 
+        std::shared_future<void> RefreshLevels(std::span<std::filesystem::path const> levelPaths) {
+            auto instance = SongLoader::RuntimeSongLoader::get_instance();
+            if (!instance) return std::future<void>();
+            return instance->RefreshLevels(levelPaths);
+        }
+
+        std::shared_future<void> LoadLevel(std::filesystem::path const& levelPath) {
+            auto instance = SongLoader::RuntimeSongLoader::get_instance();
+            if (!instance) return std::future<void>();
+            return instance->LoadLevel(levelPath);
+        }
+
+        std::shared_future<void> UnloadLevel(std::filesystem::path const& levelPath) {
+            auto instance = SongLoader::RuntimeSongLoader::get_instance();
+            if (!instance) return std::future<void>();
+            return instance->UnloadLevel(levelPath);
+        }
+
         void RefreshLevelPacks() {
             auto instance = SongLoader::RuntimeSongLoader::get_instance();
             if (!instance) return;
@@ -303,6 +392,21 @@ namespace SongCore::API {
             return instance->DeleteSong(beatmapLevel);
         }
 
+        SongLoader::LevelSortField GetLevelSortField() {
+            return Utils::LevelSortFieldFromString(config.levelSortField).value_or(SongLoader::LevelSortField::SongName);
+        }
+
+        void SetLevelSortField(SongLoader::LevelSortField field) {
+            auto fieldName = Utils::LevelSortFieldToString(field);
+            if (config.levelSortField == fieldName) return;
+            config.levelSortField = fieldName;
+            SaveConfig();
+
+            auto instance = SongLoader::RuntimeSongLoader::get_instance();
+            if (!instance || !instance->AreSongsLoaded) return;
+            instance->SortLevels(field);
+        }
+
         unordered_event_callback<std::span<SongCore::SongLoader::CustomBeatmapLevel* const>>& GetSongsLoadedEvent() {
             return _songsLoadedEvent;
         }
@@ -327,6 +431,14 @@ namespace SongCore::API {
             return _songDeletedEvent;
         }
 
+        unordered_event_callback<SongCore::SongLoader::CustomBeatmapLevel*>& GetLevelAddedEvent() {
+            return _levelAddedEvent;
+        }
+
+        unordered_event_callback<SongCore::SongLoader::CustomBeatmapLevel*>& GetLevelRemovedEvent() {
+            return _levelRemovedEvent;
+        }
+
         std::filesystem::path GetPreferredCustomLevelPath() {
             if (config.RootCustomLevelPaths.empty()) return "/sdcard/ModData/com.beatgames.beatsaber/Mods/SongCore/CustomLevels";
             return config.RootCustomLevelPaths.front();
@@ -351,6 +463,9 @@ namespace SongCore::API {
             if (itr == targetPaths.end()) {
                 targetPaths.emplace_back(path);
                 SaveConfig();
+
+                // only the new root gets searched, the levels of the other roots stay as they are
+                if (auto instance = SongLoader::RuntimeSongLoader::get_instance()) instance->LoadLevelPath(path);
             } else {
                 INFO("Path {} was already in the target collection, not adding again", path.string());
             }
@@ -362,6 +477,8 @@ namespace SongCore::API {
             if (itr != targetPaths.end()) {
                 targetPaths.erase(itr);
                 SaveConfig();
+
+                if (auto instance = SongLoader::RuntimeSongLoader::get_instance()) instance->UnloadLevelPath(path);
             } else {
                 INFO("Path {} wasn't in the target collection, nothing will happen", path.string());
             }
@@ -433,6 +550,18 @@ namespace SongCore::API {
             if (!instance) return nullptr;
             return instance->GetLevelByFunction(searchFunction);
         }
+
+        std::vector<SongCore::SongLoader::CustomBeatmapLevel*> GetLevelsMatching(std::span<SongCore::SongLoader::DifficultyMask const> clauses) {
+            auto instance = SongLoader::RuntimeSongLoader::get_instance();
+            if (!instance) return {};
+            return instance->LevelIndex.Query(clauses);
+        }
+
+        size_t CountLevelsMatching(std::span<SongCore::SongLoader::DifficultyMask const> clauses) {
+            auto instance = SongLoader::RuntimeSongLoader::get_instance();
+            if (!instance) return 0;
+            return instance->LevelIndex.Count(clauses);
+        }
     }
 
     namespace LevelSelect {
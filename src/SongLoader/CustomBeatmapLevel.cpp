@@ -1,5 +1,10 @@
 #include "SongLoader/CustomBeatmapLevel.hpp"
 #include "CustomJSONData.hpp"
+#include "SongCore.hpp"
+#include "Utils/SortKey.hpp"
+
+#include <algorithm>
+#include <filesystem>
 
 DEFINE_TYPE(SongCore::SongLoader, CustomBeatmapLevel);
 namespace SongCore::SongLoader {
@@ -49,6 +54,62 @@ CustomBeatmapLevel *CustomBeatmapLevel::New(
   level->_customBeatmapLevelSaveDataV4 = saveDataV4;
   level->_beatmapLevelData = beatmapLevelData;
 
+  // build the sort keys once here, so sorting packs never has to touch the managed strings
+  using enum LevelSortField;
+  level->_sortKeys[static_cast<size_t>(SongName)] = Utils::MakeSortKey(level, SongName);
+  level->_sortKeys[static_cast<size_t>(SongAuthorName)] = Utils::MakeSortKey(level, SongAuthorName);
+  level->_sortKeys[static_cast<size_t>(LevelAuthorName)] = Utils::MakeSortKey(level, LevelAuthorName);
+  level->_sortKeys[static_cast<size_t>(BeatsPerMinute)] = Utils::MakeSortKey(beatsPerMinute);
+
+  std::error_code error_code;
+  auto writeTime = std::filesystem::last_write_time(level->_customLevelPath, error_code);
+  level->_sortKeys[static_cast<size_t>(DateAdded)] = Utils::MakeDateSortKey(error_code ? 0 : writeTime.time_since_epoch().count());
+
   return level;
 }
+
+RequirementMask const* CustomBeatmapLevel::GetRequirements(std::string_view characteristic, GlobalNamespace::BeatmapDifficulty difficulty) const {
+  auto bit = DifficultyMask::GetBit(characteristic, difficulty);
+  if (!bit) return nullptr;
+
+  auto itr = std::lower_bound(_difficultyRequirements.begin(), _difficultyRequirements.end(), *bit, [](auto const& entry, size_t bit) { return entry.difficultyBit < bit; });
+  if (itr == _difficultyRequirements.end() || itr->difficultyBit != *bit) return nullptr;
+  return &itr->requirements;
+}
+
+bool CustomBeatmapLevel::AreRequirementStringsMet(std::string_view characteristic, GlobalNamespace::BeatmapDifficulty difficulty, RequirementMask const& capabilities) const {
+  auto saveDataInfo = CustomSaveDataInfo;
+  if (!saveDataInfo) return false;
+  auto details = saveDataInfo->get().TryGetCharacteristicAndDifficulty(std::string(characteristic), difficulty);
+  if (!details) return false;
+
+  auto const& requirements = details->get().requirements;
+  return std::all_of(requirements.begin(), requirements.end(), [&capabilities](auto const& requirement) {
+    // requirements that got an id are checked against the mask, only the ones that didn't need the registered strings
+    if (auto id = RequirementMask::FindRequirementId(requirement)) return capabilities.bits.test(*id);
+    return API::Capabilities::IsCapabilityRegistered(requirement);
+  });
+}
+
+bool CustomBeatmapLevel::IsPlayable(std::string_view characteristic, GlobalNamespace::BeatmapDifficulty difficulty, RequirementMask const& capabilities) const {
+  auto requirements = GetRequirements(characteristic, difficulty);
+  if (!requirements) return true;
+  if (!requirements->overflowed) return requirements->IsSatisfiedBy(capabilities);
+
+  // some requirement didn't get an id, so fall back to checking the strings
+  return AreRequirementStringsMet(characteristic, difficulty, capabilities);
+}
+
+bool CustomBeatmapLevel::IsPlayable(RequirementMask const& capabilities) const {
+  // any difficulty without requirements is always playable
+  if (_difficultyMask.bits.count() > _difficultyRequirements.size()) return true;
+  return std::any_of(_difficultyRequirements.begin(), _difficultyRequirements.end(), [this, &capabilities](auto const& entry) {
+    if (!entry.requirements.overflowed) return entry.requirements.IsSatisfiedBy(capabilities);
+
+    auto characteristic = DifficultyMask::GetCharacteristicForSlot(entry.difficultyBit / DifficultyMask::DifficultyCount);
+    if (!characteristic) return false;
+    auto difficulty = GlobalNamespace::BeatmapDifficulty(static_cast<GlobalNamespace::BeatmapDifficulty::__BeatmapDifficulty_Unwrapped>(entry.difficultyBit % DifficultyMask::DifficultyCount));
+    return AreRequirementStringsMet(*characteristic, difficulty, capabilities);
+  });
+}
 } // namespace SongCore::SongLoader
@@ -2,9 +2,18 @@
 #include "System/Collections/Generic/Dictionary_2.hpp"
 #include "logging.hpp"
 
+#include <vector>
+
 DEFINE_TYPE(SongCore::SongLoader, CustomBeatmapLevelsRepository);
 
 namespace SongCore::SongLoader {
+    /// @brief the levels of the pack, empty if it has none
+    static std::span<GlobalNamespace::BeatmapLevel* const> GetLevels(GlobalNamespace::BeatmapLevelPack* pack) {
+        ArrayW<GlobalNamespace::BeatmapLevel*> levels(pack->_beatmapLevels);
+        if (!levels) return {};
+        return { levels.begin(), levels.end() };
+    }
+
     void CustomBeatmapLevelsRepository::ctor() {
         INVOKE_CTOR();
         _levelPacks = ListW<GlobalNamespace::BeatmapLevelPack*>::New();
@@ -13,27 +22,161 @@ namespace SongCore::SongLoader {
 
     void CustomBeatmapLevelsRepository::AddLevelPack(GlobalNamespace::BeatmapLevelPack* pack) {
         auto itr = std::find_if(_levelPacks.begin(), _levelPacks.end(), [pack](auto x){ return x->packID == pack->packID; });
-        if (itr == _levelPacks.end()) {
-            _levelPacks->Add(pack);
-        } else {
+        if (itr != _levelPacks.end()) {
             WARNING("A pack with id {} was already added, not adding again!", pack->packID);
+            return;
         }
+
+        _levelPacks->Add(pack);
+        _beatmapLevelPacks = _levelPacks->ToArray();
+        _idToBeatmapLevelPack->TryAdd(pack->packID, pack);
+        _indexedLevels.try_emplace(pack);
+        AddLevels(pack, GetLevels(pack));
     }
 
     void CustomBeatmapLevelsRepository::RemoveLevelPack(GlobalNamespace::BeatmapLevelPack* pack) {
         auto itr = std::find_if(_levelPacks.begin(), _levelPacks.end(), [pack](auto x){ return x->packID == pack->packID; });
-        if (itr != _levelPacks.end()) {
-            _levelPacks->Remove(*itr);
-        } else {
+        if (itr == _levelPacks.end()) {
             WARNING("A pack with id {} was not added, not removing!", pack->packID);
+            return;
         }
+
+        // the pack leaves the list first, so levels it shares with other packs get pointed at those
+        auto addedPack = *itr;
+        _levelPacks->Remove(addedPack);
+        _beatmapLevelPacks = _levelPacks->ToArray();
+        _idToBeatmapLevelPack->Remove(addedPack->packID);
+
+        auto node = _indexedLevels.extract(addedPack);
+        if (node.empty()) return;
+        for (auto const& [levelID, _] : node.mapped()) RemoveLevelID(addedPack, levelID, nullptr);
+    }
+
+    bool CustomBeatmapLevelsRepository::HasLevelPack(GlobalNamespace::BeatmapLevelPack* pack) {
+        return std::find_if(_levelPacks.begin(), _levelPacks.end(), [pack](auto x){ return x->packID == pack->packID; }) != _levelPacks.end();
     }
 
     void CustomBeatmapLevelsRepository::ClearLevelPacks() {
         _levelPacks.clear();
+        _beatmapLevelPacks = _levelPacks->ToArray();
         _idToBeatmapLevelPack->Clear();
         _beatmapLevelIdToBeatmapLevelPackId->Clear();
         _idToBeatmapLevel->Clear();
+        _indexedLevels.clear();
+    }
+
+    void CustomBeatmapLevelsRepository::AddLevels(GlobalNamespace::BeatmapLevelPack* pack, std::span<GlobalNamespace::BeatmapLevel* const> levels) {
+        auto indexed = _indexedLevels.find(pack);
+        if (indexed == _indexedLevels.end()) return;
+
+        auto packID = pack->packID;
+        for (auto level : levels) {
+            if (!level) continue;
+            auto levelID = level->levelID;
+            auto& held = indexed->second[static_cast<std::u16string>(levelID)];
+            if (std::find(held.begin(), held.end(), level) != held.end()) continue;
+            held.emplace_back(level);
+            // another copy with the same id is already in the dictionaries for this pack
+            if (held.size() > 1) continue;
+
+            _beatmapLevelIdToBeatmapLevelPackId->TryAdd(levelID, packID);
+            _idToBeatmapLevel->TryAdd(levelID, level);
+        }
+    }
+
+    void CustomBeatmapLevelsRepository::RemoveLevels(GlobalNamespace::BeatmapLevelPack* pack, std::span<GlobalNamespace::BeatmapLevel* const> levels) {
+        auto indexed = _indexedLevels.find(pack);
+        if (indexed == _indexedLevels.end()) return;
+
+        for (auto level : levels) {
+            if (!level) continue;
+            auto levelID = static_cast<std::u16string>(level->levelID);
+            auto held = indexed->second.find(levelID);
+            if (held == indexed->second.end()) continue;
+            if (std::erase(held->second, level) == 0) continue;
+
+            if (held->second.empty()) {
+                indexed->second.erase(held);
+                RemoveLevelID(pack, levelID, level);
+                continue;
+            }
+
+            // the pack still holds another level with this id, like a second folder with the same hash, which takes over
+            StringW csLevelID(levelID);
+            GlobalNamespace::BeatmapLevel* mappedLevel = nullptr;
+            if (_idToBeatmapLevel->TryGetValue(csLevelID, by_ref(mappedLevel)) && mappedLevel == level) {
+                _idToBeatmapLevel->set_Item(csLevelID, held->second.front());
+            }
+        }
+    }
+
+    void CustomBeatmapLevelsRepository::UpdateLevelPack(GlobalNamespace::BeatmapLevelPack* pack) {
+        auto itr = std::find_if(_levelPacks.begin(), _levelPacks.end(), [pack](auto x){ return x->packID == pack->packID; });
+        if (itr == _levelPacks.end()) {
+            WARNING("A pack with id {} was not added, not updating!", pack->packID);
+            return;
+        }
+
+        // a different pack object with the same id replaces the added one
+        if (*itr != pack) {
+            RemoveLevelPack(*itr);
+            AddLevelPack(pack);
+            return;
+        }
+
+        // levels are compared by object, so a level reloaded under the same id counts as removed and added
+        auto& indexed = _indexedLevels[pack];
+        std::unordered_set<GlobalNamespace::BeatmapLevel*> currentLevels;
+        std::vector<GlobalNamespace::BeatmapLevel*> addedLevels;
+        for (auto level : GetLevels(pack)) {
+            if (!level || !currentLevels.emplace(level).second) continue;
+            auto held = indexed.find(static_cast<std::u16string>(level->levelID));
+            if (held == indexed.end() || std::find(held->second.begin(), held->second.end(), level) == held->second.end()) addedLevels.emplace_back(level);
+        }
+
+        std::vector<GlobalNamespace::BeatmapLevel*> removedLevels;
+        for (auto const& [_, held] : indexed) {
+            for (auto level : held) {
+                if (!currentLevels.contains(level)) removedLevels.emplace_back(level);
+            }
+        }
+
+        // added first, so a replaced level takes over its id from the old object without the id leaving the pack in between
+        AddLevels(pack, addedLevels);
+        RemoveLevels(pack, removedLevels);
+    }
+
+    void CustomBeatmapLevelsRepository::RemoveLevelID(GlobalNamespace::BeatmapLevelPack* pack, std::u16string const& levelID, GlobalNamespace::BeatmapLevel* removedLevel) {
+        StringW csLevelID(levelID);
+
+        // another pack may hold the same level, like a playlist holding a custom level, the first one of those takes over
+        for (auto other : _levelPacks) {
+            if (other == pack) continue;
+            auto indexed = _indexedLevels.find(other);
+            if (indexed == _indexedLevels.end()) continue;
+            auto held = indexed->second.find(levelID);
+            if (held == indexed->second.end()) continue;
+
+            StringW mappedPackID;
+            bool mappedToPack = _beatmapLevelIdToBeatmapLevelPackId->TryGetValue(csLevelID, by_ref(mappedPackID)) && mappedPackID == pack->packID;
+            if (mappedToPack) _beatmapLevelIdToBeatmapLevelPackId->set_Item(csLevelID, other->packID);
+
+            GlobalNamespace::BeatmapLevel* mappedLevel = nullptr;
+            bool hasMappedLevel = _idToBeatmapLevel->TryGetValue(csLevelID, by_ref(mappedLevel));
+            if (!mappedToPack && hasMappedLevel && (!removedLevel || mappedLevel != removedLevel)) return;
+
+            // if the other pack still only holds the removed level object it is stale, so it gets dropped and a reloaded level can take its place
+            auto replacement = std::find_if(held->second.begin(), held->second.end(), [removedLevel](auto x){ return x != removedLevel; });
+            if (replacement == held->second.end()) {
+                _idToBeatmapLevel->Remove(csLevelID);
+            } else {
+                _idToBeatmapLevel->set_Item(csLevelID, *replacement);
+            }
+            return;
+        }
+
+        _beatmapLevelIdToBeatmapLevelPackId->Remove(csLevelID);
+        _idToBeatmapLevel->Remove(csLevelID);
     }
 
     void CustomBeatmapLevelsRepository::FixBackingDictionaries() {
@@ -41,19 +184,15 @@ namespace SongCore::SongLoader {
         _idToBeatmapLevelPack->Clear();
         _beatmapLevelIdToBeatmapLevelPackId->Clear();
         _idToBeatmapLevel->Clear();
+        _indexedLevels.clear();
 
         // for every pack
         for (auto pack : _levelPacks) {
-            auto packID = pack->packID;
-            _idToBeatmapLevelPack->TryAdd(packID, pack);
+            _idToBeatmapLevelPack->TryAdd(pack->packID, pack);
+            _indexedLevels.try_emplace(pack);
 
             // for every level
-            for (auto level : pack->_beatmapLevels) {
-                auto levelID = level->levelID;
-
-                _beatmapLevelIdToBeatmapLevelPackId->TryAdd(levelID, packID);
-                _idToBeatmapLevel->TryAdd(levelID, level);
-            }
+            AddLevels(pack, GetLevels(pack));
         }
     }
 }
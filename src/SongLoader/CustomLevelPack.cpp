@@ -1,14 +1,19 @@
 #include "SongLoader/CustomLevelPack.hpp"
 
+#include "Utils/SortKey.hpp"
+
 #include "beatsaber-hook/shared/listw.hpp"
 
 #include <compare>
+#include <deque>
 #include <string_view>
+#include <unordered_set>
 
 DEFINE_TYPE(SongCore::SongLoader, CustomLevelPack);
 
 namespace SongCore::SongLoader {
     void CustomLevelPack::ctor(StringW packId, StringW packName, UnityEngine::Sprite* coverImage) {
+        INVOKE_CTOR();
         _ctor(packId, packName, packName, coverImage, coverImage, GlobalNamespace::PackBuyOption::DisableBuyOption, ArrayW<GlobalNamespace::BeatmapLevel*>::New(), GlobalNamespace::PlayerSensitivityFlag::Unknown);
     }
 
@@ -17,26 +22,157 @@ namespace SongCore::SongLoader {
     }
 
     void CustomLevelPack::SortLevels() {
-        SortLevels([](auto a, auto b) -> bool { return static_cast<std::u16string_view>(a->songName) < static_cast<std::u16string_view>(b->songName); });
+        SortLevels(LevelSortField::SongName);
+    }
+
+    struct LevelSortEntry {
+        std::string_view key;
+        std::string_view songNameKey;
+        GlobalNamespace::BeatmapLevel* level;
+
+        bool operator<(LevelSortEntry const& other) const {
+            if (auto cmp = key.compare(other.key); cmp != 0) return cmp < 0;
+            return songNameKey < other.songNameKey;
+        }
+    };
+
+    /// @brief levels that aren't ours have no precomputed keys, so those get built here and need to stay alive as long as the entry
+    static LevelSortEntry MakeSortEntry(GlobalNamespace::BeatmapLevel* level, LevelSortField field, std::deque<std::string>& ownedKeys) {
+        auto customLevel = i2c::try_cast<CustomBeatmapLevel*>(level);
+        auto GetKey = [&](LevelSortField keyField) -> std::string_view {
+            if (customLevel) return customLevel->GetSortKey(keyField);
+            return ownedKeys.emplace_back(Utils::MakeSortKey(level, keyField));
+        };
+
+        return {
+            GetKey(field),
+            field == LevelSortField::SongName ? std::string_view() : GetKey(LevelSortField::SongName),
+            level
+        };
+    }
+
+    /// @brief builds the sort entries for the levels, sorted by the field. keys are binary, so a plain memcmp based compare gives the right order
+    template<typename Levels>
+    static std::vector<LevelSortEntry> MakeSortedEntries(Levels const& levels, LevelSortField field, std::deque<std::string>& ownedKeys) {
+        std::vector<LevelSortEntry> entries;
+        entries.reserve(levels.size());
+        for (auto level : levels) entries.emplace_back(MakeSortEntry(level, field, ownedKeys));
+        std::stable_sort(entries.begin(), entries.end());
+        return entries;
+    }
+
+    void CustomLevelPack::SortLevels(LevelSortField field) {
+        std::deque<std::string> ownedKeys;
+        auto entries = MakeSortedEntries(_beatmapLevels, field, ownedKeys);
+
+        std::transform(entries.begin(), entries.end(), _beatmapLevels.begin(), [](LevelSortEntry const& entry) { return entry.level; });
+        _sortedBy = field;
+        UpdateAllBeatmapLevels();
+    }
+
+    void CustomLevelPack::AddLevels(std::span<CustomBeatmapLevel* const> levels, LevelSortField field) {
+        if (levels.empty()) return;
+
+        std::deque<std::string> ownedKeys;
+        ArrayW<GlobalNamespace::BeatmapLevel*> current(_beatmapLevels);
+
+        // the binary search below only works if the collection is sorted by the field, otherwise everything gets sorted together
+        if (_sortedBy != field) {
+            std::vector<GlobalNamespace::BeatmapLevel*> allLevels(current.begin(), current.end());
+            allLevels.insert(allLevels.end(), levels.begin(), levels.end());
+            auto entries = MakeSortedEntries(allLevels, field, ownedKeys);
+
+            _beatmapLevels = ArrayW<GlobalNamespace::BeatmapLevel*>(entries.size());
+            std::transform(entries.begin(), entries.end(), _beatmapLevels.begin(), [](LevelSortEntry const& entry) { return entry.level; });
+            _sortedBy = field;
+            UpdateAllBeatmapLevels();
+            return;
+        }
+
+        auto added = MakeSortedEntries(levels, field, ownedKeys);
+
+        // binary search where each added level goes, only the keys looked at along the way get built
+        ArrayW<GlobalNamespace::BeatmapLevel*> result(current.size() + added.size());
+        auto src = current.begin();
+        auto out = result.begin();
+        for (auto const& entry : added) {
+            // added levels go after levels with an equal key, same as the stable sort would put them
+            auto pos = std::upper_bound(src, current.end(), entry, [&ownedKeys, field](LevelSortEntry const& entry, GlobalNamespace::BeatmapLevel* level) {
+                return entry < MakeSortEntry(level, field, ownedKeys);
+            });
+            out = std::copy(src, pos, out);
+            *out++ = entry.level;
+            src = pos;
+        }
+        std::copy(src, current.end(), out);
+
+        _beatmapLevels = result;
+        UpdateAllBeatmapLevels();
+    }
+
+    std::vector<GlobalNamespace::BeatmapLevel*> CustomLevelPack::RemoveLevels(std::span<CustomBeatmapLevel* const> levels) {
+        std::vector<GlobalNamespace::BeatmapLevel*> removed;
+        if (levels.empty()) return removed;
+
+        std::unordered_set<GlobalNamespace::BeatmapLevel*> toRemove(levels.begin(), levels.end());
+        ArrayW<GlobalNamespace::BeatmapLevel*> current(_beatmapLevels);
+        for (auto level : current) {
+            if (toRemove.contains(level)) removed.emplace_back(level);
+        }
+        if (removed.empty()) return removed;
+
+        // the kept levels go straight into the new array
+        ArrayW<GlobalNamespace::BeatmapLevel*> result(current.size() - removed.size());
+        std::copy_if(current.begin(), current.end(), result.begin(), [&toRemove](auto level) { return !toRemove.contains(level); });
+
+        _beatmapLevels = result;
+        UpdateAllBeatmapLevels();
+        return removed;
     }
 
     void CustomLevelPack::SortLevels(WeakSortingFunc sortingFunc) {
         std::stable_sort(_beatmapLevels.begin(), _beatmapLevels.end(), sortingFunc);
+        _sortedBy = std::nullopt;
+        UpdateAllBeatmapLevels();
+    }
+
+    void CustomLevelPack::UpdateAllBeatmapLevels() {
+        ArrayW<GlobalNamespace::BeatmapLevel*> additionalLevels(_additionalBeatmapLevels);
+        size_t additionalCount = additionalLevels ? additionalLevels.size() : 0;
+        ArrayW<GlobalNamespace::BeatmapLevel*> allLevels(_beatmapLevels.size() + additionalCount);
+        auto out = std::copy(_beatmapLevels.begin(), _beatmapLevels.end(), allLevels.begin());
+        if (additionalCount > 0) std::copy(additionalLevels.begin(), additionalLevels.end(), out);
+
+        // the list takes the freshly filled array as its backing store instead of copying it again through AddRange.
+        // the array is never shared with _beatmapLevels, so changing the list can't change the pack
+        auto allBeatmapLevels = ListW<GlobalNamespace::BeatmapLevel*>::New();
+        allBeatmapLevels->_items = allLevels;
+        allBeatmapLevels->_size = allLevels.size();
+        _allBeatmapLevels = allBeatmapLevels;
     }
 
     void CustomLevelPack::SetLevels(std::span<CustomBeatmapLevel* const> levels) {
         _beatmapLevels = ArrayW<GlobalNamespace::BeatmapLevel*>(levels.size());
         std::copy(levels.begin(), levels.end(), _beatmapLevels.begin());
-        _allBeatmapLevels = ListW<GlobalNamespace::BeatmapLevel*>::New();
-        _allBeatmapLevels->AddRange(static_cast<::System::Collections::Generic::IEnumerable_1<GlobalNamespace::BeatmapLevel*>*>(_beatmapLevels.convert()));
-        _allBeatmapLevels->AddRange(static_cast<::System::Collections::Generic::IEnumerable_1<GlobalNamespace::BeatmapLevel*>*>(static_cast<void*>(_additionalBeatmapLevels)));
+        _sortedBy = std::nullopt;
+        UpdateAllBeatmapLevels();
     }
 
     void CustomLevelPack::SetLevels(std::span<GlobalNamespace::BeatmapLevel* const> levels) {
         _beatmapLevels = ArrayW<GlobalNamespace::BeatmapLevel*>(levels.size());
         std::copy(levels.begin(), levels.end(), _beatmapLevels.begin());
-        _allBeatmapLevels = ListW<GlobalNamespace::BeatmapLevel*>::New();
-        _allBeatmapLevels->AddRange(static_cast<::System::Collections::Generic::IEnumerable_1<GlobalNamespace::BeatmapLevel*>*>(_beatmapLevels.convert()));
-        _allBeatmapLevels->AddRange(static_cast<::System::Collections::Generic::IEnumerable_1<GlobalNamespace::BeatmapLevel*>*>(static_cast<void*>(_additionalBeatmapLevels)));
+        _sortedBy = std::nullopt;
+        UpdateAllBeatmapLevels();
+    }
+
+    void CustomLevelPack::SetLevels(std::span<CustomBeatmapLevel* const> levels, LevelSortField field) {
+        std::deque<std::string> ownedKeys;
+        auto entries = MakeSortedEntries(levels, field, ownedKeys);
+
+        // sorted natively, so the managed array is written once
+        _beatmapLevels = ArrayW<GlobalNamespace::BeatmapLevel*>(levels.size());
+        std::transform(entries.begin(), entries.end(), _beatmapLevels.begin(), [](LevelSortEntry const& entry) { return entry.level; });
+        _sortedBy = field;
+        UpdateAllBeatmapLevels();
     }
 }
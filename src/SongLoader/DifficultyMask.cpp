@@ -0,0 +1,92 @@
+#include "SongLoader/DifficultyMask.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace SongCore::SongLoader {
+    static std::shared_mutex _characteristicSlotsMutex;
+    static std::vector<std::string> _characteristicSlots;
+
+    /// @brief expects the slots to be locked
+    static std::optional<size_t> FindSlotLocked(std::string_view serializedName) {
+        auto itr = std::find(_characteristicSlots.begin(), _characteristicSlots.end(), serializedName);
+        if (itr == _characteristicSlots.end()) return std::nullopt;
+        return std::distance(_characteristicSlots.begin(), itr);
+    }
+
+    std::optional<size_t> DifficultyMask::GetCharacteristicSlot(std::string_view serializedName) {
+        {
+            std::shared_lock<std::shared_mutex> lock(_characteristicSlotsMutex);
+            if (auto slot = FindSlotLocked(serializedName)) return slot;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(_characteristicSlotsMutex);
+        // another thread may have assigned it in between the locks
+        if (auto slot = FindSlotLocked(serializedName)) return slot;
+        if (_characteristicSlots.size() >= MaxCharacteristics) return std::nullopt;
+
+        _characteristicSlots.emplace_back(serializedName);
+        return _characteristicSlots.size() - 1;
+    }
+
+    std::optional<size_t> DifficultyMask::FindCharacteristicSlot(std::string_view serializedName) {
+        std::shared_lock<std::shared_mutex> lock(_characteristicSlotsMutex);
+        return FindSlotLocked(serializedName);
+    }
+
+    static std::optional<size_t> BitForSlot(std::optional<size_t> slot, GlobalNamespace::BeatmapDifficulty difficulty) {
+        auto difficultyIndex = static_cast<int>(difficulty);
+        if (!slot || difficultyIndex < 0 || static_cast<size_t>(difficultyIndex) >= DifficultyMask::DifficultyCount) return std::nullopt;
+        return *slot * DifficultyMask::DifficultyCount + difficultyIndex;
+    }
+
+    std::optional<size_t> DifficultyMask::GetBit(std::string_view serializedName, GlobalNamespace::BeatmapDifficulty difficulty) {
+        return BitForSlot(FindCharacteristicSlot(serializedName), difficulty);
+    }
+
+    std::optional<std::string> DifficultyMask::GetCharacteristicForSlot(size_t slot) {
+        std::shared_lock<std::shared_mutex> lock(_characteristicSlotsMutex);
+        if (slot >= _characteristicSlots.size()) return std::nullopt;
+        return _characteristicSlots[slot];
+    }
+
+    DifficultyMask& DifficultyMask::Set(std::string_view serializedName, GlobalNamespace::BeatmapDifficulty difficulty) {
+        if (auto bit = BitForSlot(GetCharacteristicSlot(serializedName), difficulty)) bits.set(*bit);
+        return *this;
+    }
+
+    DifficultyMask& DifficultyMask::Set(std::string_view serializedName) {
+        auto slot = GetCharacteristicSlot(serializedName);
+        if (!slot) return *this;
+        for (size_t i = 0; i < DifficultyCount; i++) bits.set(*slot * DifficultyCount + i);
+        return *this;
+    }
+
+    DifficultyMask& DifficultyMask::With(std::string_view serializedName, GlobalNamespace::BeatmapDifficulty difficulty) {
+        if (auto bit = GetBit(serializedName, difficulty)) bits.set(*bit);
+        return *this;
+    }
+
+    DifficultyMask& DifficultyMask::With(std::string_view serializedName) {
+        auto slot = FindCharacteristicSlot(serializedName);
+        if (!slot) return *this;
+        for (size_t i = 0; i < DifficultyCount; i++) bits.set(*slot * DifficultyCount + i);
+        return *this;
+    }
+
+    bool DifficultyMask::Has(std::string_view serializedName, GlobalNamespace::BeatmapDifficulty difficulty) const {
+        auto bit = GetBit(serializedName, difficulty);
+        return bit && bits.test(*bit);
+    }
+
+    bool DifficultyMask::Has(std::string_view serializedName) const {
+        auto slot = FindCharacteristicSlot(serializedName);
+        if (!slot) return false;
+        for (size_t i = 0; i < DifficultyCount; i++) {
+            if (bits.test(*slot * DifficultyCount + i)) return true;
+        }
+        return false;
+    }
+}
@@ -0,0 +1,183 @@
+#include "SongLoader/LevelIndex.hpp"
+#include "SongLoader/CustomBeatmapLevel.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace SongCore::SongLoader {
+    template<typename F>
+    void LevelIndex::ForEachBitmap(F&& func) {
+        for (auto& bitmap : _bitmaps) if (!bitmap.empty()) func(bitmap);
+        for (auto& bitmap : _requirementBitmaps) if (!bitmap.empty()) func(bitmap);
+        func(_levelsWithRequirements);
+    }
+
+    void LevelIndex::Build(std::span<CustomBeatmapLevel* const> levels) {
+        _levels.assign(levels.begin(), levels.end());
+        _wordCount = (_levels.size() + 63) / 64;
+        for (auto& bitmap : _bitmaps) bitmap.clear();
+        for (auto& bitmap : _requirementBitmaps) bitmap.clear();
+        _levelsWithRequirements.assign(_wordCount, 0);
+
+        for (size_t levelIdx = 0; levelIdx < _levels.size(); levelIdx++) SetBits(levelIdx);
+    }
+
+    void LevelIndex::Add(CustomBeatmapLevel* level) {
+        auto levelIdx = _levels.size();
+        _levels.push_back(level);
+        ResizeBitmaps((_levels.size() + 63) / 64);
+        SetBits(levelIdx);
+    }
+
+    bool LevelIndex::Remove(CustomBeatmapLevel* level) {
+        auto itr = std::find(_levels.begin(), _levels.end(), level);
+        if (itr == _levels.end()) return false;
+
+        // the last level takes the place of the removed one, so only its bits have to move
+        size_t levelIdx = std::distance(_levels.begin(), itr);
+        size_t lastIdx = _levels.size() - 1;
+        ForEachBitmap([levelIdx, lastIdx](Bitmap& bitmap) {
+            auto lastBit = (bitmap[lastIdx / 64] >> (lastIdx % 64)) & 1;
+            bitmap[levelIdx / 64] = (bitmap[levelIdx / 64] & ~(uint64_t(1) << (levelIdx % 64))) | (lastBit << (levelIdx % 64));
+            bitmap[lastIdx / 64] &= ~(uint64_t(1) << (lastIdx % 64));
+        });
+
+        _levels[levelIdx] = _levels[lastIdx];
+        _levels.pop_back();
+        ResizeBitmaps((_levels.size() + 63) / 64);
+        return true;
+    }
+
+    void LevelIndex::SetBits(size_t levelIdx) {
+        auto level = _levels[levelIdx];
+        auto levelBit = uint64_t(1) << (levelIdx % 64);
+        auto const& bits = level->difficultyMask.bits;
+
+        for (size_t bit = 0; bit < DifficultyMask::BitCount && bits.any(); bit++) {
+            if (!bits.test(bit)) continue;
+            auto& bitmap = _bitmaps[bit];
+            if (bitmap.empty()) bitmap.resize(_wordCount);
+            bitmap[levelIdx / 64] |= levelBit;
+        }
+
+        auto difficultyRequirements = level->difficultyRequirements;
+        if (difficultyRequirements.empty()) return;
+        _levelsWithRequirements[levelIdx / 64] |= levelBit;
+
+        RequirementMask levelRequirements;
+        for (auto const& entry : difficultyRequirements) levelRequirements.bits |= entry.requirements.bits;
+        for (size_t id = 0; id < RequirementMask::MaxRequirements; id++) {
+            if (!levelRequirements.bits.test(id)) continue;
+            auto& bitmap = _requirementBitmaps[id];
+            if (bitmap.empty()) bitmap.resize(_wordCount);
+            bitmap[levelIdx / 64] |= levelBit;
+        }
+    }
+
+    void LevelIndex::ResizeBitmaps(size_t wordCount) {
+        if (wordCount == _wordCount) return;
+        _wordCount = wordCount;
+        ForEachBitmap([wordCount](Bitmap& bitmap) { bitmap.resize(wordCount); });
+    }
+
+    void LevelIndex::OrBitmaps(DifficultyMask const& mask, Bitmap& out) const {
+        for (size_t bit = 0; bit < DifficultyMask::BitCount; bit++) {
+            if (!mask.bits.test(bit)) continue;
+            auto const& bitmap = _bitmaps[bit];
+            if (bitmap.empty()) continue;
+
+            // plain word loops, these get vectorized by the compiler
+            auto src = bitmap.data();
+            auto dst = out.data();
+            for (size_t i = 0; i < _wordCount; i++) dst[i] |= src[i];
+        }
+    }
+
+    LevelIndex::Bitmap LevelIndex::Match(std::span<DifficultyMask const> clauses) const {
+        Bitmap result(_wordCount, ~uint64_t(0));
+        // clear the bits past the last level
+        if (auto tail = _levels.size() % 64; tail != 0) result.back() = (uint64_t(1) << tail) - 1;
+
+        Bitmap clauseBitmap(_wordCount);
+        for (auto const& clause : clauses) {
+            std::fill(clauseBitmap.begin(), clauseBitmap.end(), 0);
+            OrBitmaps(clause, clauseBitmap);
+
+            auto src = clauseBitmap.data();
+            auto dst = result.data();
+            for (size_t i = 0; i < _wordCount; i++) dst[i] &= src[i];
+        }
+
+        return result;
+    }
+
+    size_t LevelIndex::Count(std::span<DifficultyMask const> clauses) const {
+        size_t count = 0;
+        for (auto word : Match(clauses)) count += std::popcount(word);
+        return count;
+    }
+
+    std::vector<CustomBeatmapLevel*> LevelIndex::Query(std::span<DifficultyMask const> clauses) const {
+        return GetLevels(Match(clauses));
+    }
+
+    LevelIndex::Bitmap LevelIndex::MatchRequirement(std::string_view requirement) const {
+        auto id = RequirementMask::FindRequirementId(requirement);
+        if (!id || _requirementBitmaps[*id].empty()) return Bitmap(_wordCount);
+        return _requirementBitmaps[*id];
+    }
+
+    std::vector<CustomBeatmapLevel*> LevelIndex::GetLevelsRequiring(std::string_view requirement) const {
+        return GetLevels(MatchRequirement(requirement));
+    }
+
+    LevelIndex::Bitmap LevelIndex::MatchPlayable(RequirementMask const& capabilities) const {
+        auto result = Match({});
+
+        // only levels with requirements need an actual check, everything else is always playable
+        for (size_t wordIdx = 0; wordIdx < _wordCount; wordIdx++) {
+            auto word = _levelsWithRequirements[wordIdx];
+            while (word) {
+                auto bit = std::countr_zero(word);
+                if (!_levels[wordIdx * 64 + bit]->IsPlayable(capabilities)) result[wordIdx] &= ~(uint64_t(1) << bit);
+                word &= word - 1;
+            }
+        }
+
+        return result;
+    }
+
+    std::vector<CustomBeatmapLevel*> LevelIndex::GetLevelsUnlockedBy(std::string_view capability, RequirementMask const& capabilities) const {
+        std::vector<CustomBeatmapLevel*> levels;
+        auto id = RequirementMask::FindRequirementId(capability);
+        if (!id || _requirementBitmaps[*id].empty()) return levels;
+
+        auto withCapability = capabilities;
+        withCapability.bits.set(*id);
+
+        // only levels that require the capability somewhere can change playability
+        for (auto level : GetLevels(_requirementBitmaps[*id])) {
+            if (!level->IsPlayable(capabilities) && level->IsPlayable(withCapability)) levels.emplace_back(level);
+        }
+
+        return levels;
+    }
+
+    std::vector<CustomBeatmapLevel*> LevelIndex::GetLevels(Bitmap const& bitmap) const {
+        std::vector<CustomBeatmapLevel*> levels;
+        size_t count = 0;
+        for (auto word : bitmap) count += std::popcount(word);
+        levels.reserve(count);
+
+        for (size_t wordIdx = 0; wordIdx < bitmap.size() && wordIdx < _wordCount; wordIdx++) {
+            auto word = bitmap[wordIdx];
+            while (word) {
+                auto bit = std::countr_zero(word);
+                levels.emplace_back(_levels[wordIdx * 64 + bit]);
+                word &= word - 1;
+            }
+        }
+
+        return levels;
+    }
+}
@@ -14,6 +14,8 @@
 #include "Utils/WavRiff.hpp"
 #include "Utils/Cache.hpp"
 #include "Utils/Errors.hpp"
+#include "Utils/JsonArena.hpp"
+#include "config.hpp"
 
 #include "bsml/shared/Helpers/utilities.hpp"
 #include "GlobalNamespace/BeatmapDifficultySerializedMethods.hpp"
@@ -76,8 +78,20 @@ namespace SongCore::SongLoader {
         }
 
         try {
-            auto text = Utils::ReadText(infoPath);
-            auto standardSaveData = LoadCustomSaveData(GlobalNamespace::StandardLevelInfoSaveData::DeserializeFromJSONString(text), text);
+            auto text = Utils::ReadUTF8Text(infoPath);
+            // one native parse, the text buffer is reused for the DOM strings
+            auto document = Utils::ParseCompactDocumentInsitu(text, "loading custom level info v2");
+            if (!document) {
+                ERROR("Cannot load file from path: {}!", path.string());
+                return nullptr;
+            }
+
+            GlobalNamespace::StandardLevelInfoSaveData* standardSaveData = BuildCustomSaveData(document, infoPath);
+            if (!standardSaveData) {
+                // the text was consumed by the in situ parse, so the base game deserializer gets the document written back out
+                auto saveData = GlobalNamespace::StandardLevelInfoSaveData::DeserializeFromJSONString(StringW(Utils::WriteJson(*document)));
+                standardSaveData = LoadCustomSaveData(saveData, document, infoPath);
+            }
 
             if (!standardSaveData) {
                 ERROR("Cannot load file from path: {}!", path.string());
@@ -115,8 +129,15 @@ namespace SongCore::SongLoader {
         }
 
         try {
-            auto infoText = Utils::ReadText(infoPath);
-            auto beatmapLevelSaveData = LoadCustomSaveData(Newtonsoft::Json::JsonConvert::DeserializeObject<BeatmapLevelSaveDataVersion4::BeatmapLevelSaveData*>(infoText), infoText);
+            auto infoText = Utils::ReadUTF8Text(infoPath);
+            // the managed string is made first, after that the text can be parsed in situ
+            auto saveData = Newtonsoft::Json::JsonConvert::DeserializeObject<BeatmapLevelSaveDataVersion4::BeatmapLevelSaveData*>(StringW(infoText));
+            auto document = Utils::ParseCompactDocumentInsitu(infoText, "loading custom level info v4");
+            if (!document) {
+                ERROR("Cannot load file from path: {}!", path.string());
+                return nullptr;
+            }
+            auto beatmapLevelSaveData = LoadCustomSaveData(saveData, document, infoPath);
 
             if (!beatmapLevelSaveData) {
                 ERROR("Cannot load file from path: {}!", path.string());
@@ -138,6 +159,32 @@ namespace SongCore::SongLoader {
         return nullptr;
     }
 
+    /// @brief builds the requirement masks for the loaded difficulties of a level
+    static std::vector<DifficultyRequirements> GetDifficultyRequirements(CustomBeatmapLevel* level) {
+        std::vector<DifficultyRequirements> result;
+        auto saveDataInfo = level->CustomSaveDataInfo;
+        if (!saveDataInfo) return result;
+        auto details = saveDataInfo->get().TryGetBasicLevelDetails();
+        if (!details) return result;
+
+        for (auto const& [characteristicName, detailsSet] : details->get().characteristicNameToBeatmapDetailsSet) {
+            for (auto const& [difficulty, difficultyDetails] : detailsSet.difficultyToDifficultyBeatmapDetails) {
+                if (difficultyDetails.requirements.empty()) continue;
+
+                // only difficulties that actually got loaded matter
+                auto bit = DifficultyMask::GetBit(characteristicName, GlobalNamespace::BeatmapDifficulty(difficulty));
+                if (!bit || !level->difficultyMask.bits.test(*bit)) continue;
+
+                RequirementMask requirements;
+                for (auto const& requirement : difficultyDetails.requirements) requirements.Set(requirement);
+                result.emplace_back(static_cast<uint16_t>(*bit), requirements);
+            }
+        }
+
+        std::sort(result.begin(), result.end(), [](auto const& a, auto const& b) { return a.difficultyBit < b.difficultyBit; });
+        return result;
+    }
+
     StringW EmptyString() {
         static ConstString empty("");
         return empty;
@@ -218,7 +265,8 @@ namespace SongCore::SongLoader {
         auto allLighters = ArrayW<StringW>::New();
 
         auto previewMediaData = GetPreviewMediaData(levelPath, saveData->coverImageFilename, saveData->songFilename);
-        auto [beatmapLevelData, beatmapBasicData] = GetBeatmapLevelAndBasicData(levelPath, levelId, environmentNameList, colorSchemes, saveData);
+        DifficultyMask difficultyMask;
+        auto [beatmapLevelData, beatmapBasicData] = GetBeatmapLevelAndBasicData(levelPath, levelId, environmentNameList, colorSchemes, saveData, difficultyMask);
 
         if(beatmapBasicData->Count == 0) {
             return nullptr;
@@ -246,6 +294,8 @@ namespace SongCore::SongLoader {
             previewMediaData->i___GlobalNamespace__IPreviewMediaData(),
             beatmapBasicData
         );
+        result->_difficultyMask = difficultyMask;
+        result->_difficultyRequirements = GetDifficultyRequirements(result);
 
         return result;
     }
@@ -288,7 +338,8 @@ namespace SongCore::SongLoader {
         float songDuration = GetLengthForLevel(levelPath, saveData);
 
         auto previewMediaData = GetPreviewMediaData(levelPath, saveData->coverImageFilename, saveData->audio.songFilename);
-        auto [beatmapLevelData, beatmapBasicData] = GetBeatmapLevelAndBasicData(levelPath, levelId, saveData);
+        DifficultyMask difficultyMask;
+        auto [beatmapLevelData, beatmapBasicData] = GetBeatmapLevelAndBasicData(levelPath, levelId, saveData, difficultyMask);
 
         if(beatmapBasicData->Count == 0) {
             return nullptr;
@@ -328,13 +379,15 @@ namespace SongCore::SongLoader {
             previewMediaData->i___GlobalNamespace__IPreviewMediaData(),
             beatmapBasicData
         );
+        result->_difficultyMask = difficultyMask;
+        result->_difficultyRequirements = GetDifficultyRequirements(result);
 
         return result;
     }
 
 
     // V2 | V3
-    std::pair<GlobalNamespace::FileSystemBeatmapLevelData*, LevelLoader::BeatmapBasicDataDict*> LevelLoader::GetBeatmapLevelAndBasicData(std::filesystem::path const& levelPath, std::string_view levelID, std::span<GlobalNamespace::EnvironmentName const> environmentNames, std::span<GlobalNamespace::ColorScheme* const> colorSchemes, CustomJSONData::CustomLevelInfoSaveDataV2* saveData) {
+    std::pair<GlobalNamespace::FileSystemBeatmapLevelData*, LevelLoader::BeatmapBasicDataDict*> LevelLoader::GetBeatmapLevelAndBasicData(std::filesystem::path const& levelPath, std::string_view levelID, std::span<GlobalNamespace::EnvironmentName const> environmentNames, std::span<GlobalNamespace::ColorScheme* const> colorSchemes, CustomJSONData::CustomLevelInfoSaveDataV2* saveData, DifficultyMask& difficultyMaskOut) {
         auto fileDifficultyBeatmapsDict = System::Collections::Generic::Dictionary_2<CharacteristicDifficultyPair, GlobalNamespace::FileDifficultyBeatmap*>::New_ctor();
         auto basicDataDict = LevelLoader::BeatmapBasicDataDict::New_ctor();
         bool saveDataHadEnvNames = saveData->environmentNames.size() > 0;
@@ -420,6 +473,7 @@ namespace SongCore::SongLoader {
                         ArrayW<StringW>::New()
                     )
                 );
+                difficultyMaskOut.Set(characteristicInfo.serializedName, difficulty);
             }
         }
 
@@ -436,7 +490,7 @@ namespace SongCore::SongLoader {
 
     // V4
     // implementation of CustomLevelLoader.CreateBeatmapLevelDataFromV4
-    std::pair<GlobalNamespace::FileSystemBeatmapLevelData*, LevelLoader::BeatmapBasicDataDict*> LevelLoader::GetBeatmapLevelAndBasicData(std::filesystem::path const& levelPath, std::string_view levelID, CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData) {
+    std::pair<GlobalNamespace::FileSystemBeatmapLevelData*, LevelLoader::BeatmapBasicDataDict*> LevelLoader::GetBeatmapLevelAndBasicData(std::filesystem::path const& levelPath, std::string_view levelID, CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData, DifficultyMask& difficultyMaskOut) {
         auto fileDifficultyBeatmapsDict = System::Collections::Generic::Dictionary_2<CharacteristicDifficultyPair, GlobalNamespace::FileDifficultyBeatmap*>::New_ctor();
         auto basicDataDict = LevelLoader::BeatmapBasicDataDict::New_ctor();
 
@@ -599,6 +653,7 @@ namespace SongCore::SongLoader {
                         lighters.to_array()
                     )
                 );
+            difficultyMaskOut.Set(characteristicInfo.serializedName, difficulty);
         }
 
         return {
@@ -908,7 +963,133 @@ namespace SongCore::SongLoader {
         return true;
     }
 
-    SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* LevelLoader::LoadCustomSaveData(GlobalNamespace::StandardLevelInfoSaveData* saveData, std::u16string_view stringData) {
+    /// @brief gets the level details ready while still on the loader thread, so the main thread only ever reads them. they come from the song cache
+    /// if the level folder didn't change, otherwise they are parsed and cached. after that the document is dropped if configured
+    static void FinishCustomSaveDataInfo(SongCore::CustomJSONData::CustomSaveDataInfo& info, std::filesystem::path const& infoPath) {
+        std::optional<Utils::CachedSongData> cachedInfo;
+        if (!infoPath.empty()) cachedInfo = Utils::GetCachedInfo(infoPath.parent_path());
+
+        if (cachedInfo && cachedInfo->levelDetails) {
+            info.SetLevelDetails(cachedInfo->levelDetails);
+        } else if (info.PrepareLevelDetails() && cachedInfo) {
+            cachedInfo->levelDetails = info.levelDetails;
+            Utils::SetCachedInfo(infoPath.parent_path(), *cachedInfo);
+        }
+
+        if (!config.keepInfoDocuments) info.ReleaseDocument();
+    }
+
+    static StringW GetStringW(SongCore::CustomJSONData::ValueUTF8 const& obj, char const* key) {
+        auto itr = obj.FindMember(key);
+        if (itr == obj.MemberEnd() || !itr->value.IsString()) return EmptyString();
+        return StringW(std::string_view(itr->value.GetString(), itr->value.GetStringLength()));
+    }
+
+    static float GetFloat(SongCore::CustomJSONData::ValueUTF8 const& obj, char const* key) {
+        auto itr = obj.FindMember(key);
+        if (itr == obj.MemberEnd() || !itr->value.IsNumber()) return 0.0f;
+        return itr->value.GetFloat();
+    }
+
+    static int GetInt(SongCore::CustomJSONData::ValueUTF8 const& obj, char const* key) {
+        auto itr = obj.FindMember(key);
+        if (itr == obj.MemberEnd() || !itr->value.IsNumber()) return 0;
+        return itr->value.IsInt() ? itr->value.GetInt() : static_cast<int>(itr->value.GetDouble());
+    }
+
+    SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* LevelLoader::BuildCustomSaveData(std::shared_ptr<SongCore::CustomJSONData::DocumentUTF8 const> sharedDoc, std::filesystem::path const& infoPath) {
+        auto const& doc = *sharedDoc;
+        if (!doc.IsObject()) return nullptr;
+
+        auto beatmapSetsItr = doc.FindMember("_difficultyBeatmapSets");
+        if (beatmapSetsItr == doc.MemberEnd() || !beatmapSetsItr->value.IsArray()) return nullptr;
+        // color schemes are nested managed types, leave those to the base game deserializer
+        auto colorSchemesItr = doc.FindMember("_colorSchemes");
+        if (colorSchemesItr != doc.MemberEnd() && colorSchemesItr->value.IsArray() && !colorSchemesItr->value.Empty()) return nullptr;
+
+        ArrayW<StringW> environmentNames(il2cpp_array_size_t(0));
+        auto environmentNamesItr = doc.FindMember("_environmentNames");
+        if (environmentNamesItr != doc.MemberEnd() && environmentNamesItr->value.IsArray()) {
+            auto const& namesArr = environmentNamesItr->value;
+            environmentNames = ArrayW<StringW>(il2cpp_array_size_t(namesArr.Size()));
+            for (rapidjson::SizeType i = 0; i < namesArr.Size(); i++) {
+                environmentNames[i] = namesArr[i].IsString() ? StringW(std::string_view(namesArr[i].GetString(), namesArr[i].GetStringLength())) : EmptyString();
+            }
+        }
+
+        auto const& beatmapSetsArr = beatmapSetsItr->value;
+        auto customBeatmapSets = ArrayW<GlobalNamespace::StandardLevelInfoSaveData::DifficultyBeatmapSet*>(il2cpp_array_size_t(beatmapSetsArr.Size()));
+
+        SongCore::CustomJSONData::CustomLevelInfoSaveDataV2 *customSaveData =
+                SongCore::CustomJSONData::CustomLevelInfoSaveDataV2::New_ctor(
+                    GetStringW(doc, "_songName"),
+                    GetStringW(doc, "_songSubName"),
+                    GetStringW(doc, "_songAuthorName"),
+                    GetStringW(doc, "_levelAuthorName"),
+                    GetFloat(doc, "_beatsPerMinute"),
+                    GetFloat(doc, "_songTimeOffset"),
+                    GetFloat(doc, "_shuffle"),
+                    GetFloat(doc, "_shufflePeriod"),
+                    GetFloat(doc, "_previewStartTime"),
+                    GetFloat(doc, "_previewDuration"),
+                    GetStringW(doc, "_songFilename"),
+                    GetStringW(doc, "_coverImageFilename"),
+                    GetStringW(doc, "_environmentName"),
+                    GetStringW(doc, "_allDirectionsEnvironmentName"),
+                    environmentNames,
+                    ArrayW<GlobalNamespace::BeatmapLevelColorSchemeSaveData*>(il2cpp_array_size_t(0)),
+                    customBeatmapSets
+                );
+
+        customSaveData->_customSaveDataInfo = SongCore::CustomJSONData::CustomSaveDataInfo();
+        customSaveData->_customSaveDataInfo->saveDataVersion = SongCore::CustomJSONData::CustomSaveDataInfo::SaveDataVersion::V3;
+        customSaveData->_customSaveDataInfo->SetDocument(infoPath, sharedDoc);
+        auto document = customSaveData->_customSaveDataInfo->document;
+
+        for (rapidjson::SizeType i = 0; i < beatmapSetsArr.Size(); i++) {
+            SongCore::CustomJSONData::ValueUTF8 const& beatmapSetJson = beatmapSetsArr[i];
+
+            auto difficultyBeatmapsItr = beatmapSetJson.FindMember("_difficultyBeatmaps");
+            auto difficultyBeatmapsSize = (difficultyBeatmapsItr != beatmapSetJson.MemberEnd() && difficultyBeatmapsItr->value.IsArray()) ? difficultyBeatmapsItr->value.Size() : 0;
+            auto customBeatmaps = ArrayW<GlobalNamespace::StandardLevelInfoSaveData::DifficultyBeatmap *>(il2cpp_array_size_t(difficultyBeatmapsSize));
+
+            for (rapidjson::SizeType j = 0; j < difficultyBeatmapsSize; j++) {
+                SongCore::CustomJSONData::ValueUTF8 const& difficultyBeatmapJson = difficultyBeatmapsItr->value[j];
+
+                auto customBeatmap =
+                    SongCore::CustomJSONData::CustomDifficultyBeatmap::New_ctor(
+                        GetStringW(difficultyBeatmapJson, "_difficulty"),
+                        GetInt(difficultyBeatmapJson, "_difficultyRank"),
+                        GetStringW(difficultyBeatmapJson, "_beatmapFilename"),
+                        GetFloat(difficultyBeatmapJson, "_noteJumpMovementSpeed"),
+                        GetFloat(difficultyBeatmapJson, "_noteJumpStartBeatOffset"),
+                        GetInt(difficultyBeatmapJson, "_beatmapColorSchemeIdx"),
+                        GetInt(difficultyBeatmapJson, "_environmentNameIdx")
+                    );
+
+                if (difficultyBeatmapJson.HasMember("_customData")) {
+                    customBeatmap->_customData = SongCore::CustomJSONData::DocumentValueRef(document, fmt::format("/_difficultyBeatmapSets/{}/_difficultyBeatmaps/{}/_customData", i, j));
+                }
+
+                customBeatmaps[j] = customBeatmap;
+            }
+
+            auto customBeatmapSet = SongCore::CustomJSONData::CustomDifficultyBeatmapSet::New_ctor(
+                GetStringW(beatmapSetJson, "_beatmapCharacteristicName"),
+                customBeatmaps
+            );
+
+            if (beatmapSetJson.HasMember("_customData")) {
+                customBeatmapSet->_customData = SongCore::CustomJSONData::DocumentValueRef(document, fmt::format("/_difficultyBeatmapSets/{}/_customData", i));
+            }
+
+            customBeatmapSets[i] = customBeatmapSet;
+        }
+        FinishCustomSaveDataInfo(*customSaveData->_customSaveDataInfo, infoPath);
+        return customSaveData;
+    }
+
+    SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* LevelLoader::LoadCustomSaveData(GlobalNamespace::StandardLevelInfoSaveData* saveData, std::shared_ptr<SongCore::CustomJSONData::DocumentUTF8 const> sharedDoc, std::filesystem::path const& infoPath) {
         if (!saveData) {
             WARNING("Save Data is not valid!");
             return nullptr;
@@ -942,35 +1123,26 @@ namespace SongCore::SongLoader {
                 );
 
 
-        auto sharedDoc = std::make_shared<SongCore::CustomJSONData::DocumentUTF16>();
+        if (!sharedDoc) return nullptr;
+
         customSaveData->_customSaveDataInfo = SongCore::CustomJSONData::CustomSaveDataInfo();
         customSaveData->_customSaveDataInfo->saveDataVersion = SongCore::CustomJSONData::CustomSaveDataInfo::SaveDataVersion::V3;
-        customSaveData->_customSaveDataInfo->doc = sharedDoc;
-
-        rapidjson::GenericDocument<rapidjson::UTF16<char16_t>> &doc = *sharedDoc;
-        doc.Parse(stringData.data());
-        if (doc.HasParseError()) {
-            Utils::PrintJSONError<rapidjson::UTF16<char16_t>>(doc, "loading custom level info v2", stringData);
-            return nullptr;
-        }
+        customSaveData->_customSaveDataInfo->SetDocument(infoPath, sharedDoc);
+        auto document = customSaveData->_customSaveDataInfo->document;
+        auto const& doc = *sharedDoc;
 
-        auto dataItr = doc.FindMember(u"_customData");
-        if (dataItr != doc.MemberEnd()) {
-            customSaveData->_customSaveDataInfo->customData = dataItr->value;
-        }
-
-        SongCore::CustomJSONData::ValueUTF16 const& beatmapSetsArr = doc.FindMember(u"_difficultyBeatmapSets")->value;
+        SongCore::CustomJSONData::ValueUTF8 const& beatmapSetsArr = doc.FindMember("_difficultyBeatmapSets")->value;
 
         for (rapidjson::SizeType i = 0; i < beatmapSetsArr.Size(); i++) {
-            SongCore::CustomJSONData::ValueUTF16 const& beatmapSetJson = beatmapSetsArr[i];
+            SongCore::CustomJSONData::ValueUTF8 const& beatmapSetJson = beatmapSetsArr[i];
 
             auto originalBeatmapSet = saveData->difficultyBeatmapSets[i];
             auto customBeatmaps = ArrayW<GlobalNamespace::StandardLevelInfoSaveData::DifficultyBeatmap *>(originalBeatmapSet->difficultyBeatmaps.size());
 
-            auto const& difficultyBeatmaps = beatmapSetJson.FindMember(u"_difficultyBeatmaps")->value;
+            auto const& difficultyBeatmaps = beatmapSetJson.FindMember("_difficultyBeatmaps")->value;
 
             for (rapidjson::SizeType j = 0; j < originalBeatmapSet->difficultyBeatmaps.size(); j++) {
-                SongCore::CustomJSONData::ValueUTF16 const& difficultyBeatmapJson = difficultyBeatmaps[j];
+                SongCore::CustomJSONData::ValueUTF8 const& difficultyBeatmapJson = difficultyBeatmaps[j];
                 auto originalBeatmap = originalBeatmapSet->difficultyBeatmaps[j];
 
                 auto customBeatmap =
@@ -984,9 +1156,9 @@ namespace SongCore::SongLoader {
                         originalBeatmap->environmentNameIdx
                     );
 
-                auto customDataItr = difficultyBeatmapJson.FindMember(u"_customData");
+                auto customDataItr = difficultyBeatmapJson.FindMember("_customData");
                 if (customDataItr != difficultyBeatmapJson.MemberEnd()) {
-                    customBeatmap->customData = customDataItr->value;
+                    customBeatmap->_customData = SongCore::CustomJSONData::DocumentValueRef(document, fmt::format("/_difficultyBeatmapSets/{}/_difficultyBeatmaps/{}/_customData", i, j));
                 }
 
                 customBeatmaps[j] = customBeatmap;
@@ -997,17 +1169,18 @@ namespace SongCore::SongLoader {
                 customBeatmaps
             );
 
-            auto customDataItr = beatmapSetJson.FindMember(u"_customData");
+            auto customDataItr = beatmapSetJson.FindMember("_customData");
             if (customDataItr != beatmapSetJson.MemberEnd()) {
-                customBeatmapSet->customData = customDataItr->value;
+                customBeatmapSet->_customData = SongCore::CustomJSONData::DocumentValueRef(document, fmt::format("/_difficultyBeatmapSets/{}/_customData", i));
             }
 
             customBeatmapSets[i] = customBeatmapSet;
         }
+        FinishCustomSaveDataInfo(*customSaveData->_customSaveDataInfo, infoPath);
         return customSaveData;
     }
 
-    SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* LevelLoader::LoadCustomSaveData(BeatmapLevelSaveDataVersion4::BeatmapLevelSaveData* saveData, std::u16string_view stringData) {
+    SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* LevelLoader::LoadCustomSaveData(BeatmapLevelSaveDataVersion4::BeatmapLevelSaveData* saveData, std::shared_ptr<SongCore::CustomJSONData::DocumentUTF8 const> sharedDoc, std::filesystem::path const& infoPath) {
         if (!saveData) {
             WARNING("Save Data is not valid!");
             return nullptr;
@@ -1030,29 +1203,18 @@ namespace SongCore::SongLoader {
         customSaveData->environmentNames = saveData->environmentNames;
         customSaveData->version = saveData->version;
 
-        std::u16string_view str(stringData);
+        if (!sharedDoc) return nullptr;
 
-        auto sharedDoc = std::make_shared<SongCore::CustomJSONData::DocumentUTF16>();
         customSaveData->_customSaveDataInfo = SongCore::CustomJSONData::CustomSaveDataInfo();
         customSaveData->_customSaveDataInfo->saveDataVersion = SongCore::CustomJSONData::CustomSaveDataInfo::SaveDataVersion::V4;
-        customSaveData->_customSaveDataInfo->doc = sharedDoc;
-
-        rapidjson::GenericDocument<rapidjson::UTF16<char16_t>> &doc = *sharedDoc;
-        doc.Parse(str.data());
-        if (doc.HasParseError()) {
-            Utils::PrintJSONError(doc, "loading custom level info v4", str);
-            return nullptr;
-        }
-
-        auto dataItr = doc.FindMember(u"customData");
-        if (dataItr != doc.MemberEnd()) {
-            customSaveData->_customSaveDataInfo->customData = dataItr->value;
-        }
+        customSaveData->_customSaveDataInfo->SetDocument(infoPath, sharedDoc);
+        auto document = customSaveData->_customSaveDataInfo->document;
+        auto const& doc = *sharedDoc;
 
-        SongCore::CustomJSONData::ValueUTF16 const& beatmapsArr = doc.FindMember(u"difficultyBeatmaps")->value;
+        SongCore::CustomJSONData::ValueUTF8 const& beatmapsArr = doc.FindMember("difficultyBeatmaps")->value;
 
         for (rapidjson::SizeType i = 0; i < beatmapsArr.Size(); i++) {
-            SongCore::CustomJSONData::ValueUTF16 const& diffBeatmapJson = beatmapsArr[i];
+            SongCore::CustomJSONData::ValueUTF8 const& diffBeatmapJson = beatmapsArr[i];
 
             auto originalDiffBeatmap = saveData->difficultyBeatmaps[i];
             auto customDiffBeatmap = SongCore::CustomJSONData::CustomDifficultyBeatmapV4::New_ctor(
@@ -1067,13 +1229,14 @@ namespace SongCore::SongLoader {
                 originalDiffBeatmap->noteJumpStartBeatOffset
             );
 
-            auto customDataItr = diffBeatmapJson.FindMember(u"customData");
+            auto customDataItr = diffBeatmapJson.FindMember("customData");
             if (customDataItr != diffBeatmapJson.MemberEnd()) {
-                customDiffBeatmap->customData = customDataItr->value;
+                customDiffBeatmap->_customData = SongCore::CustomJSONData::DocumentValueRef(document, fmt::format("/difficultyBeatmaps/{}/customData", i));
             }
 
             customDiffBeatmaps[i] = customDiffBeatmap;
         }
+        FinishCustomSaveDataInfo(*customSaveData->_customSaveDataInfo, infoPath);
         return customSaveData;
     }
 }
@@ -0,0 +1,79 @@
+#include "SongLoader/LevelRegistry.hpp"
+#include "SongLoader/CustomBeatmapLevel.hpp"
+
+#include "beatsaber-hook/shared/utils/il2cpp-functions.hpp"
+
+#include <mutex>
+
+namespace SongCore::SongLoader {
+    LevelRegistry::~LevelRegistry() {
+        Clear();
+    }
+
+    LevelRegistry::Shard& LevelRegistry::GetShard(std::string_view levelPath) {
+        return _shards[PathHash()(levelPath) % ShardCount];
+    }
+
+    LevelRegistry::Shard const& LevelRegistry::GetShard(std::string_view levelPath) const {
+        return _shards[PathHash()(levelPath) % ShardCount];
+    }
+
+    CustomBeatmapLevel* LevelRegistry::Find(std::string_view levelPath) const {
+        auto& shard = GetShard(levelPath);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto itr = shard.levels.find(levelPath);
+        if (itr == shard.levels.end()) return nullptr;
+        return itr->second.level;
+    }
+
+    bool LevelRegistry::TryAdd(std::string_view levelPath, CustomBeatmapLevel* level) {
+        auto& shard = GetShard(levelPath);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto [itr, added] = shard.levels.try_emplace(std::string(levelPath), Entry{ level, 0 });
+        if (!added) return false;
+        itr->second.gcHandle = il2cpp_functions::gchandle_new(reinterpret_cast<Il2CppObject*>(level), false);
+
+        _count.fetch_add(1, std::memory_order_relaxed);
+        _version.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+    CustomBeatmapLevel* LevelRegistry::Remove(std::string_view levelPath) {
+        auto& shard = GetShard(levelPath);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto itr = shard.levels.find(levelPath);
+        if (itr == shard.levels.end()) return nullptr;
+
+        auto level = itr->second.level;
+        il2cpp_functions::gchandle_free(itr->second.gcHandle);
+        shard.levels.erase(itr);
+        _count.fetch_sub(1, std::memory_order_relaxed);
+        _version.fetch_add(1, std::memory_order_release);
+        return level;
+    }
+
+    void LevelRegistry::Clear() {
+        for (auto& shard : _shards) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            _count.fetch_sub(shard.levels.size(), std::memory_order_relaxed);
+            for (auto const& [_, entry] : shard.levels) il2cpp_functions::gchandle_free(entry.gcHandle);
+            shard.levels.clear();
+        }
+        _version.fetch_add(1, std::memory_order_release);
+    }
+
+    void LevelRegistry::AppendLevels(std::vector<CustomBeatmapLevel*>& out) const {
+        out.reserve(out.size() + Count);
+        for (auto& shard : _shards) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (auto const& [_, entry] : shard.levels) out.emplace_back(entry.level);
+        }
+    }
+
+    void LevelRegistry::ForEach(std::function<void(std::string_view, CustomBeatmapLevel*)> const& func) const {
+        for (auto& shard : _shards) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (auto const& [levelPath, entry] : shard.levels) func(levelPath, entry.level);
+        }
+    }
+}
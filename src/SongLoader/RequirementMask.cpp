@@ -0,0 +1,68 @@
+#include "SongLoader/RequirementMask.hpp"
+#include "logging.hpp"
+
+#include <cctype>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace SongCore::SongLoader {
+    static std::shared_mutex _requirementIdsMutex;
+    static std::unordered_map<std::string, uint16_t> _requirementIds;
+
+    std::string RequirementMask::Sanitize(std::string_view requirement) {
+        std::string sanitized;
+        sanitized.reserve(requirement.size());
+        for (auto c : requirement) {
+            if (isspace(c)) continue;
+            sanitized.push_back(tolower(c));
+        }
+        return sanitized;
+    }
+
+    std::optional<uint16_t> RequirementMask::GetRequirementId(std::string_view requirement) {
+        auto sanitized = Sanitize(requirement);
+        {
+            std::shared_lock<std::shared_mutex> lock(_requirementIdsMutex);
+            auto itr = _requirementIds.find(sanitized);
+            if (itr != _requirementIds.end()) return itr->second;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(_requirementIdsMutex);
+        // another thread may have assigned it in between the locks
+        auto itr = _requirementIds.find(sanitized);
+        if (itr != _requirementIds.end()) return itr->second;
+        if (_requirementIds.size() >= MaxRequirements) {
+            WARNING("Ran out of requirement ids, requirement '{}' will be checked by name", requirement);
+            return std::nullopt;
+        }
+
+        uint16_t id = _requirementIds.size();
+        _requirementIds.emplace(std::move(sanitized), id);
+        return id;
+    }
+
+    std::optional<uint16_t> RequirementMask::FindRequirementId(std::string_view requirement) {
+        auto sanitized = Sanitize(requirement);
+        std::shared_lock<std::shared_mutex> lock(_requirementIdsMutex);
+        auto itr = _requirementIds.find(sanitized);
+        if (itr == _requirementIds.end()) return std::nullopt;
+        return itr->second;
+    }
+
+    RequirementMask& RequirementMask::Set(std::string_view requirement) {
+        if (auto id = GetRequirementId(requirement)) bits.set(*id);
+        else overflowed = true;
+        return *this;
+    }
+
+    RequirementMask& RequirementMask::Reset(std::string_view requirement) {
+        if (auto id = FindRequirementId(requirement)) bits.reset(*id);
+        return *this;
+    }
+
+    bool RequirementMask::Has(std::string_view requirement) const {
+        auto id = FindRequirementId(requirement);
+        return id && bits.test(*id);
+    }
+}
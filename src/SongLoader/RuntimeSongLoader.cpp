@@ -10,13 +10,16 @@
 #include "assets.hpp"
 
 #include "paper2_scotland2/shared/utfcpp/source/utf8.h"
-#include "beatsaber-hook/shared/threading.hpp"
-#include "bsml/shared/BSML/MainThreadScheduler.hpp"
 #include "bsml/shared/Helpers/utilities.hpp"
 
+#include <unordered_set>
+
 #include "Utils/Hashing.hpp"
 #include "Utils/File.hpp"
 #include "Utils/Cache.hpp"
+#include "Utils/MainThread.hpp"
+#include "Utils/ThreadPool.hpp"
+#include "Utils/SortKey.hpp"
 
 #include "System/Collections/Generic/ICollection_1.hpp"
 #include "System/Collections/Generic/IEnumerable_1.hpp"
@@ -28,7 +31,6 @@
 
 DEFINE_TYPE(SongCore::SongLoader, RuntimeSongLoader);
 
-#define MAX_THREAD_COUNT 8
 
 using namespace std::chrono;
 
@@ -73,11 +75,84 @@ namespace SongCore::SongLoader {
     void RuntimeSongLoader::Dispose() {
         if (_instance == this) _instance = nullptr;
 
-        _customLevels->Clear();
-        _customWIPLevels->Clear();
+        // a running pass holds on to the partitions, so they are only cleared once it is done
+        OnRefreshCompleted([this]() {
+            {
+                std::unique_lock<std::shared_mutex> lock(_partitionsMutex);
+                _partitions.clear();
+            }
+            _customLevels->Clear();
+            _customWIPLevels->Clear();
+        });
+    }
+
+    SongDict* RuntimeSongLoader::get_customLevels() {
+        SyncSongDict(_customLevels, false, _customLevelsSyncedVersions);
+        return _customLevels;
+    }
+
+    SongDict* RuntimeSongLoader::get_customWIPLevels() {
+        SyncSongDict(_customWIPLevels, true, _customWIPLevelsSyncedVersions);
+        return _customWIPLevels;
+    }
+
+    void RuntimeSongLoader::SyncSongDict(SongDict* dict, bool isWip, std::vector<std::pair<uint64_t, uint64_t>>& syncedVersions) {
+        std::lock_guard<std::mutex> syncLock(_songDictSyncMutex);
+        std::shared_lock<std::shared_mutex> lock(_partitionsMutex);
+
+        // versions are read before copying, a change during the copy then gets picked up by the next sync
+        std::vector<std::pair<uint64_t, uint64_t>> versions;
+        for (auto const& partition : _partitions) {
+            if (partition->isWip == isWip) versions.emplace_back(partition->id, partition->levels.Version);
+        }
+        if (versions == syncedVersions) return;
+
+        dict->Clear();
+        for (auto const& partition : _partitions) {
+            if (partition->isWip != isWip) continue;
+            partition->levels.ForEach([dict](std::string_view levelPath, CustomBeatmapLevel* level) {
+                dict->TryAdd(StringW(levelPath), level);
+            });
+        }
+        syncedVersions = std::move(versions);
+    }
+
+    /// @brief whether the path is inside the root
+    static bool IsInRoot(std::filesystem::path const& path, std::filesystem::path const& root) {
+        auto relative = path.lexically_normal().lexically_relative(root.lexically_normal());
+        return !relative.empty() && *relative.begin() != "..";
+    }
+
+    /// @brief whether the folder holds an info.dat
+    static bool HasInfoDat(std::filesystem::path const& levelPath) {
+        return std::filesystem::exists(levelPath / "info.dat") || std::filesystem::exists(levelPath / "Info.dat");
+    }
+
+    bool RuntimeSongLoader::IsWipRoot(std::filesystem::path const& root) const {
+        // a root listed as both only loads once, as a non wip root
+        if (std::find(config.RootCustomLevelPaths.begin(), config.RootCustomLevelPaths.end(), root) != config.RootCustomLevelPaths.end()) return false;
+        return std::find(config.RootCustomWIPLevelPaths.begin(), config.RootCustomWIPLevelPaths.end(), root) != config.RootCustomWIPLevelPaths.end();
     }
 
-    void RuntimeSongLoader::CollectLevels(std::filesystem::path const& root, bool isWip, std::set<LevelPathAndWip>& out) {
+    void RuntimeSongLoader::CollectLevels(LevelPartition& partition, std::set<LevelPathAndWip>& out) {
+        auto const& root = partition.root;
+        if (!std::filesystem::exists(root)) {
+            WARNING("Attempted to load songs from folder '{}' but it did not exist! skipping...", root.string());
+            return;
+        }
+
+        // roots nested in this one collect their own levels, so their folders are skipped here
+        std::vector<std::filesystem::path> nestedRoots;
+        {
+            std::shared_lock<std::shared_mutex> lock(_partitionsMutex);
+            auto normalRoot = root.lexically_normal();
+            for (auto const& other : _partitions) {
+                if (other.get() == &partition || other->root.empty()) continue;
+                auto normalOther = other->root.lexically_normal();
+                if (normalOther != normalRoot && IsInRoot(normalOther, normalRoot)) nestedRoots.emplace_back(std::move(normalOther));
+            }
+        }
+
         // recursively find folders in this root folder to load songs from
         std::error_code error_code;
         auto iterator = std::filesystem::recursive_directory_iterator(root, error_code);
@@ -86,11 +161,16 @@ namespace SongCore::SongLoader {
             return;
         }
 
-        for (auto entry : iterator) {
+        for (auto itr = std::filesystem::begin(iterator); itr != std::filesystem::end(iterator); ++itr) {
+            auto const& entry = *itr;
             if (!entry.is_directory()) continue;
             auto songPath = entry.path();
             // if this is an autosaves dir, just skip silently
             if (songPath.string().ends_with("autosaves")) continue;
+            if (std::find(nestedRoots.begin(), nestedRoots.end(), songPath.lexically_normal()) != nestedRoots.end()) {
+                itr.disable_recursion_pending();
+                continue;
+            }
 
             auto dataPath = songPath / "info.dat";
             if (!std::filesystem::exists(dataPath)) {
@@ -101,86 +181,377 @@ namespace SongCore::SongLoader {
                 }
             }
 
-            out.emplace(songPath, isWip);
+            out.emplace(songPath, partition.isWip, &partition);
         }
     }
 
-    void RuntimeSongLoader::CollectLevels(std::span<const std::filesystem::path> roots, bool isWip, std::set<LevelPathAndWip>& out) {
-        for (auto& rootPath : roots) {
-            if (!std::filesystem::exists(rootPath)) {
-                WARNING("Attempted to load songs from folder '{}' but it did not exist! skipping...", rootPath.string());
-                continue;
+    RuntimeSongLoader::LevelPartition& RuntimeSongLoader::GetPartition(std::filesystem::path const& root, bool isWip) {
+        std::unique_lock<std::shared_mutex> lock(_partitionsMutex);
+        auto itr = std::find_if(_partitions.begin(), _partitions.end(), [&root, isWip](auto const& partition) { return partition->root == root && partition->isWip == isWip; });
+        if (itr != _partitions.end()) return **itr;
+
+        auto& partition = _partitions.emplace_back(std::make_unique<LevelPartition>());
+        partition->root = root;
+        partition->isWip = isWip;
+        partition->id = _nextPartitionId++;
+        return *partition;
+    }
+
+    RuntimeSongLoader::LevelPartition& RuntimeSongLoader::GetPartitionFor(std::filesystem::path const& levelPath) {
+        {
+            // the deepest root wins, in case roots are nested
+            std::shared_lock<std::shared_mutex> lock(_partitionsMutex);
+            LevelPartition* found = nullptr;
+            for (auto const& partition : _partitions) {
+                if (partition->root.empty() || !IsInRoot(levelPath, partition->root)) continue;
+                if (!found || IsInRoot(partition->root, found->root)) found = partition.get();
             }
+            if (found) return *found;
+        }
+
+        return GetPartition({}, false);
+    }
+
+    void RuntimeSongLoader::TrackExtraRoots(RefreshRequest const& request) {
+        auto IsConfigRoot = [this](std::filesystem::path const& root) {
+            return std::find(config.RootCustomLevelPaths.begin(), config.RootCustomLevelPaths.end(), root) != config.RootCustomLevelPaths.end() ||
+                std::find(config.RootCustomWIPLevelPaths.begin(), config.RootCustomWIPLevelPaths.end(), root) != config.RootCustomWIPLevelPaths.end();
+        };
 
-            CollectLevels(rootPath, isWip, out);
+        for (auto const& root : request.rootPaths) {
+            if (!IsConfigRoot(root)) _extraRootPaths.insert(root);
         }
+        for (auto const& root : request.unloadRootPaths) _extraRootPaths.erase(root);
     }
 
-    std::shared_future<void> RuntimeSongLoader::RefreshSongs(bool fullRefresh) {
-        if (AreSongsRefreshing) {
-            INFO("Refresh was requested while songs were refreshing, queueing up a new refresh for afterwards, or returning the already queued up refresh");
-            // if double future isn't valid, that means we need to make a new one here
-            if (!_doubleRefreshRequestedFuture.valid()) {
-                std::unique_lock<std::shared_mutex> writingLock(_doubleRefreshMutex);
-                // if it wasn't marked as a full refresh, mark it as such
-                _doubleRefreshIsFull = fullRefresh;
-                _doubleRefreshRequestedFuture = il2cpp_async(std::launch::async, &RuntimeSongLoader::RefreshRequestedWhileRefreshing, this);
-            } else {
-                // if the double refresh isn't full, update it
-                if (!_doubleRefreshIsFull) {
-                    std::unique_lock<std::shared_mutex> writingLock(_doubleRefreshMutex);
-                    _doubleRefreshIsFull = fullRefresh;
-                }
+    std::vector<RuntimeSongLoader::LevelPartition*> RuntimeSongLoader::SyncPartitions(RefreshRequest const& request) {
+        TrackExtraRoots(request);
+
+        std::vector<LevelPartition*> partitions;
+        auto Keep = [this, &partitions, &request](std::filesystem::path const& root, bool isWip) {
+            // roots unloaded in this pass are dropped, config roots come back with the next refresh
+            if (request.unloadRootPaths.contains(root)) return;
+            auto itr = std::find_if(_partitions.begin(), _partitions.end(), [&root, isWip](auto const& partition) { return partition->root == root && partition->isWip == isWip; });
+            if (itr == _partitions.end()) {
+                auto& partition = _partitions.emplace_back(std::make_unique<LevelPartition>());
+                partition->root = root;
+                partition->isWip = isWip;
+                partition->id = _nextPartitionId++;
+                itr = std::prev(_partitions.end());
             }
+            if (std::find(partitions.begin(), partitions.end(), itr->get()) == partitions.end()) partitions.emplace_back(itr->get());
+        };
+
+        std::unique_lock<std::shared_mutex> lock(_partitionsMutex);
+        for (auto const& root : config.RootCustomLevelPaths) Keep(root, false);
+        for (auto const& root : config.RootCustomWIPLevelPaths) {
+            if (IsWipRoot(root)) Keep(root, true);
+        }
+        for (auto const& root : _extraRootPaths) Keep(root, false);
+
+        // roots that were removed from the config go away with their levels, levels loaded from outside the roots stay unless everything is reloaded
+        bool dropLoose = request.full;
+        std::erase_if(_partitions, [&partitions, dropLoose](auto const& partition) {
+            if (partition->root.empty()) return dropLoose;
+            return std::find(partitions.begin(), partitions.end(), partition.get()) == partitions.end();
+        });
+        for (auto const& partition : _partitions) {
+            if (partition->root.empty()) partitions.emplace_back(partition.get());
+        }
+
+        return partitions;
+    }
+
+    RuntimeSongLoader::LevelPartition* RuntimeSongLoader::FindPartition(std::filesystem::path const& root) {
+        std::shared_lock<std::shared_mutex> lock(_partitionsMutex);
+        auto itr = std::find_if(_partitions.begin(), _partitions.end(), [&root](auto const& partition) { return !partition->root.empty() && partition->root == root; });
+        return itr != _partitions.end() ? itr->get() : nullptr;
+    }
+
+    void RuntimeSongLoader::DropPartition(LevelPartition* partition) {
+        std::unique_lock<std::shared_mutex> lock(_partitionsMutex);
+        std::erase_if(_partitions, [partition](auto const& p) { return p.get() == partition; });
+    }
+
+    CustomBeatmapLevel* RuntimeSongLoader::FindLevel(std::string_view levelPath) const {
+        std::shared_lock<std::shared_mutex> lock(_partitionsMutex);
+        for (auto const& partition : _partitions) {
+            if (auto level = partition->levels.Find(levelPath)) return level;
+        }
+        return nullptr;
+    }
+
+    CustomBeatmapLevel* RuntimeSongLoader::RemoveLevel(std::string_view levelPath) {
+        std::shared_lock<std::shared_mutex> lock(_partitionsMutex);
+        for (auto const& partition : _partitions) {
+            if (auto level = partition->levels.Remove(levelPath)) return level;
+        }
+        return nullptr;
+    }
+
+    void RuntimeSongLoader::AppendLevels(bool isWip, std::vector<CustomBeatmapLevel*>& out) const {
+        std::shared_lock<std::shared_mutex> lock(_partitionsMutex);
+        for (auto const& partition : _partitions) {
+            if (partition->isWip == isWip) partition->levels.AppendLevels(out);
+        }
+    }
+
+    std::shared_future<void> RuntimeSongLoader::RefreshSongs(bool fullRefresh) {
+        return QueueRefresh([fullRefresh](RefreshRequest& request) {
+            request.collectAll = true;
+            request.full |= fullRefresh;
+        });
+    }
+
+    std::shared_future<void> RuntimeSongLoader::RefreshLevels(std::span<std::filesystem::path const> levelPaths) {
+        return QueueRefresh([levelPaths](RefreshRequest& request) {
+            for (auto const& levelPath : levelPaths) request.Load(levelPath);
+        });
+    }
+
+    std::shared_future<void> RuntimeSongLoader::LoadLevel(std::filesystem::path const& levelPath) {
+        return QueueRefresh([&levelPath](RefreshRequest& request) { request.Load(levelPath); });
+    }
+
+    std::shared_future<void> RuntimeSongLoader::UnloadLevel(std::filesystem::path const& levelPath) {
+        return QueueRefresh([&levelPath](RefreshRequest& request) { request.Unload(levelPath); });
+    }
+
+    std::shared_future<void> RuntimeSongLoader::LoadLevelPath(std::filesystem::path const& root) {
+        return QueueRefresh([&root](RefreshRequest& request) { request.LoadRoot(root); });
+    }
+
+    std::shared_future<void> RuntimeSongLoader::UnloadLevelPath(std::filesystem::path const& root) {
+        return QueueRefresh([&root](RefreshRequest& request) { request.UnloadRoot(root); });
+    }
+
+    // whatever was asked last for a path is what happens to it
+    void RuntimeSongLoader::RefreshRequest::Load(std::filesystem::path const& levelPath) {
+        unloadPaths.erase(levelPath);
+        levelPaths.insert(levelPath);
+    }
+
+    void RuntimeSongLoader::RefreshRequest::Unload(std::filesystem::path const& levelPath) {
+        levelPaths.erase(levelPath);
+        unloadPaths.insert(levelPath);
+    }
 
-            std::shared_lock<std::shared_mutex> readingLock(_doubleRefreshMutex);
-            return _doubleRefreshRequestedFuture;
+    void RuntimeSongLoader::RefreshRequest::LoadRoot(std::filesystem::path const& root) {
+        unloadRootPaths.erase(root);
+        rootPaths.insert(root);
+    }
+
+    void RuntimeSongLoader::RefreshRequest::UnloadRoot(std::filesystem::path const& root) {
+        rootPaths.erase(root);
+        unloadRootPaths.insert(root);
+    }
+
+    std::shared_future<void> RuntimeSongLoader::QueueRefresh(std::function<void(RefreshRequest&)> const& merge) {
+        std::unique_lock<std::mutex> lock(_refreshMutex);
+
+        // a pass is running, so fold this request into the one pass that runs after it
+        auto request = _isRefreshing ? _pendingRefresh : std::make_shared<RefreshRequest>();
+        if (!request) {
+            INFO("Refresh was requested while songs were refreshing, queueing up a new refresh for afterwards");
+            request = _pendingRefresh = std::make_shared<RefreshRequest>();
         }
 
-        std::unique_lock<std::shared_mutex> writingLock(_currentRefreshMutex);
-        _currentlyLoadingFuture = il2cpp_async(std::launch::async, &RuntimeSongLoader::RefreshSongs_internal, this, std::forward<bool>(fullRefresh));
-        return _currentlyLoadingFuture;
+        merge(*request);
+
+        if (_isRefreshing) return request->future;
+
+        _isRefreshing.store(true, std::memory_order_release);
+        lock.unlock();
+
+        Utils::ThreadPool::Get().Enqueue([this, request](){ RunRefreshPasses(request); }, Utils::ThreadPool::Lane::Loading);
+        return request->future;
     }
 
-    void RuntimeSongLoader::RefreshRequestedWhileRefreshing() {
-        // while old refresh still going, wait
-        std::shared_lock<std::shared_mutex> currentRefreshReadLock(_currentRefreshMutex);
-        auto currentRefreshFuture = _currentlyLoadingFuture;
-        currentRefreshReadLock.unlock();
+    void RuntimeSongLoader::RunRefreshPasses(std::shared_ptr<RefreshRequest> request) {
+        while (request) {
+            try {
+                RefreshSongs_internal(*request);
+                request->promise.set_value();
+            } catch (std::exception const& e) {
+                ERROR("Caught exception of type {} while refreshing songs, what: {}", typeid(e).name(), e.what());
+                request->promise.set_exception(std::current_exception());
+            } catch (...) {
+                ERROR("Caught exception of unknown type (current_exception typeid: {}) while refreshing songs", typeid(std::current_exception()).name());
+                request->promise.set_exception(std::current_exception());
+            }
+
+            std::vector<std::function<void()>> callbacks;
+            {
+                std::lock_guard<std::mutex> lock(_refreshMutex);
+                request = std::move(_pendingRefresh);
+                if (request) continue;
 
-        currentRefreshFuture.wait();
+                _isRefreshing.store(false, std::memory_order_release);
+                callbacks = std::move(_refreshCompletedCallbacks);
+                _refreshCompletedCallbacks.clear();
+            }
 
-        // queue up another refresh
-        currentRefreshFuture = RefreshSongs(_doubleRefreshIsFull);
+            // callbacks may queue a new refresh, so they run outside of the lock
+            for (auto& callback : callbacks) {
+                try {
+                    callback();
+                } catch (std::exception const& e) {
+                    ERROR("Caught exception of type {} in a refresh completed callback, what: {}", typeid(e).name(), e.what());
+                }
+            }
+        }
+    }
 
-        // overwrite current loading future with this double request future since we want to
-        // then allow a refresh requested during *this* one to be allowed to overwrite the double refresh
+    void RuntimeSongLoader::OnRefreshCompleted(std::function<void()> callback) {
         {
-            std::unique_lock<std::shared_mutex> currentRefreshWriteLock(_currentRefreshMutex);
-            std::unique_lock<std::shared_mutex> doubleRefreshWriteLock(_doubleRefreshMutex);
-            _currentlyLoadingFuture = std::move(_doubleRefreshRequestedFuture);
+            std::lock_guard<std::mutex> lock(_refreshMutex);
+            if (_isRefreshing) {
+                _refreshCompletedCallbacks.emplace_back(std::move(callback));
+                return;
+            }
         }
 
-        // wait for our queued refresh to finish
-        currentRefreshFuture.wait();
+        callback();
     }
 
-    void RuntimeSongLoader::RefreshSongs_internal(bool fullRefresh) {
-        // AreRefreshing is already false here, but areLoaded may be true depending on whether this is a new reload or not
+    void RuntimeSongLoader::RefreshSongs_internal(RefreshRequest const& request) {
+        if (!request.collectAll && !request.full) return UpdateLevels_internal(request);
+
+        // areLoaded may be true depending on whether this is a new reload or not
         InvokeSongsWillRefresh();
 
         auto refreshStartTime = high_resolution_clock::now();
-        std::set<LevelPathAndWip> levels;
         _areSongsLoaded = false;
         _loadedSongs = 0;
+        _totalSongs = 0;
+
+        using namespace std::chrono;
+        auto loadStartTime = high_resolution_clock::now();
+
+        // every root refreshes as its own job, so a slow or broken root does not hold up or take down the others
+        auto partitions = SyncPartitions(request);
+        for (auto const& levelPath : request.levelPaths) {
+            // requested levels from outside every root need the loose partition, even if nothing was loaded into it yet
+            auto& partition = GetPartitionFor(levelPath);
+            if (std::find(partitions.begin(), partitions.end(), &partition) == partitions.end()) partitions.emplace_back(&partition);
+        }
+        auto& pool = Utils::ThreadPool::Get();
+        std::vector<std::future<void>> partitionFutures;
+        partitionFutures.reserve(partitions.size());
+        for (auto partition : partitions) {
+            partitionFutures.emplace_back(
+                pool.Submit(
+                    [this, partition, &request](){ RefreshPartition(*partition, request); },
+                    Utils::ThreadPool::Lane::Loading
+                )
+            );
+        }
+
+        // this thread is a pool worker too, so it picks up loading work while it waits
+        for (size_t i = 0; i < partitionFutures.size(); i++) {
+            pool.Wait(partitionFutures[i]);
+            try {
+                partitionFutures[i].get();
+            } catch (std::exception const& e) {
+                ERROR("Caught exception of type {} while refreshing root '{}', what: {}", typeid(e).name(), partitions[i]->root.string(), e.what());
+            }
+        }
+
+        size_t actualCount = 0;
+        for (auto partition : partitions) actualCount += partition->levels.Count;
 
-        // travel the given song paths to collect levels to load
-        CollectLevels(config.RootCustomLevelPaths, false, levels);
-        CollectLevels(config.RootCustomWIPLevelPaths, true, levels);
+        auto time = high_resolution_clock::now() - loadStartTime;
+        if (auto ms = duration_cast<milliseconds>(time).count(); ms > 0) {
+            INFO("Loaded {} (actual: {}) songs in {}ms", (size_t)_totalSongs, actualCount, ms);
+        } else {
+            auto µs = (float)duration_cast<nanoseconds>(time).count() / 1000.0f;
+            INFO("Loaded {} (actual: {}) songs in {}us", (size_t)_totalSongs, actualCount, µs);
+        }
+
+        // save cache to file after all songs are loaded
+        Utils::SaveSongInfoCache();
+
+        auto collectionUpdateStartTime = high_resolution_clock::now();
+
+        // one vector holds every level, other levels first and wip levels after them, the packs each take their part of it.
+        // this is where the partitions get merged back into the single view the packs show
+        std::vector<CustomBeatmapLevel*> allLevels;
+        allLevels.reserve(actualCount);
+        AppendLevels(false, allLevels);
+        auto wipLevelsStart = allLevels.size();
+        AppendLevels(true, allLevels);
+
+        auto sortField = Utils::LevelSortFieldFromString(config.levelSortField).value_or(LevelSortField::SongName);
+
+        // the lookups and index are built here, only the swap and the pack updates happen on the main thread
+        std::unordered_map<std::string, CustomBeatmapLevel*> levelIdsToLevels;
+        std::unordered_map<std::string, CustomBeatmapLevel*> hashesToLevels;
+        levelIdsToLevels.reserve(allLevels.size());
+        hashesToLevels.reserve(allLevels.size());
+
+        for (auto const level : allLevels) {
+            std::string levelID = lowerString(static_cast<std::string>(level->levelID));
+
+            levelIdsToLevels[levelID] = level;
+            hashesToLevels[std::string(GetHashFromLevelID(levelID))] = level;
+        }
+
+        SongCore::SongLoader::LevelIndex levelIndex;
+        levelIndex.Build(allLevels);
+
+        // the collections and packs are read from the main thread without locks, so they only ever change on it
+        Utils::RunOnMainThread([&]() {
+            std::span<CustomBeatmapLevel* const> allLevelsSpan(allLevels);
+            _customLevelPack->SetLevels(allLevelsSpan.first(wipLevelsStart), sortField);
+            _customWIPLevelPack->SetLevels(allLevelsSpan.subspan(wipLevelsStart), sortField);
+
+            // touch collections as short as possible by using move
+            _allLoadedLevels = std::move(allLevels);
+            _levelIdsToLevels = std::move(levelIdsToLevels);
+            _hashesToLevels = std::move(hashesToLevels);
+            _levelIndex = std::move(levelIndex);
+
+            INFO("Updated collections after load in {}ms", duration_cast<milliseconds>(high_resolution_clock::now() - collectionUpdateStartTime).count());
+
+            RefreshLevelPacks();
+        }).get();
+
+        InvokeSongsLoaded(_allLoadedLevels);
+        _areSongsLoaded = true;
+        INFO("Refresh performed in {}ms", duration_cast<milliseconds>(high_resolution_clock::now() - refreshStartTime).count());
+    }
+
+    void RuntimeSongLoader::RefreshPartition(LevelPartition& partition, RefreshRequest const& request) {
+        auto startTime = high_resolution_clock::now();
+        std::set<LevelPathAndWip> levels;
+
+        if (!partition.root.empty()) {
+            // travel the root to collect levels to load
+            CollectLevels(partition, levels);
+        } else {
+            // levels from outside every root are only ever loaded on request, so keep the ones that are still there
+            partition.levels.ForEach([&levels, &partition](std::string_view levelPath, CustomBeatmapLevel*) {
+                levels.emplace(std::filesystem::path(levelPath), partition.isWip, &partition);
+            });
+            for (auto const& levelPath : request.levelPaths) {
+                if (&GetPartitionFor(levelPath) == &partition) levels.emplace(levelPath, partition.isWip, &partition);
+            }
+            std::erase_if(levels, [](LevelPathAndWip const& level) { return !HasInfoDat(level.levelPath); });
+        }
+
+        // levels are compared by path only, so the wip status does not matter here
+        for (auto const& levelPath : request.unloadPaths) levels.erase(LevelPathAndWip{ levelPath, false });
 
-        if (fullRefresh) {
-            CustomLevels->Clear();
-            CustomWIPLevels->Clear();
+        if (request.full) {
+            partition.levels.Clear();
+        } else {
+            // drop levels that are gone from disk, and the requested ones so they get loaded again
+            std::vector<std::string> stalePaths;
+            partition.levels.ForEach([&levels, &request, &stalePaths](std::string_view levelPath, CustomBeatmapLevel*) {
+                std::filesystem::path path(levelPath);
+                if (!levels.contains(LevelPathAndWip{ path, false }) || request.levelPaths.contains(path)) stalePaths.emplace_back(levelPath);
+            });
+            for (auto const& levelPath : stalePaths) partition.levels.Remove(levelPath);
         }
 
         // load songs on multiple threads
@@ -188,103 +559,157 @@ namespace SongCore::SongLoader {
         std::set<LevelPathAndWip>::const_iterator levelsItr = levels.begin();
         std::set<LevelPathAndWip>::const_iterator levelsEnd = levels.end();
 
-        using namespace std::chrono;
-        auto loadStartTime = high_resolution_clock::now();
-
-        auto workerThreadCount = std::clamp<size_t>(levels.size(), 1, MAX_THREAD_COUNT);
+        auto& pool = Utils::ThreadPool::Get();
+        auto workerThreadCount = std::clamp<size_t>(levels.size(), 1, pool.threadCount);
         std::vector<std::future<void>> songLoadFutures;
         songLoadFutures.reserve(workerThreadCount);
-        _totalSongs = levels.size();
+        _totalSongs += levels.size();
 
-        INFO("Now going to load {} levels on {} threads", (int)_totalSongs, workerThreadCount);
+        INFO("Now going to load {} levels from '{}' on {} threads", levels.size(), partition.root.string(), workerThreadCount);
         for (int i = 0; i < workerThreadCount; i++) {
             songLoadFutures.emplace_back(
-                il2cpp_async(
-                    &RuntimeSongLoader::RefreshSongWorkerThread,
-                    this,
-                    &levelsItrMutex,
-                    &levelsItr,
-                    &levelsEnd
+                pool.Submit(
+                    [this, &levelsItrMutex, &levelsItr, &levelsEnd](){ RefreshSongWorkerThread(&levelsItrMutex, &levelsItr, &levelsEnd); },
+                    Utils::ThreadPool::Lane::Loading
                 )
             );
         }
 
         for (auto& t : songLoadFutures) {
-            t.wait();
+            pool.Wait(t);
         }
 
-        size_t actualCount = _customLevels->Count + _customWIPLevels->Count;
-        auto time = high_resolution_clock::now() - loadStartTime;
-        if (auto ms = duration_cast<milliseconds>(time).count(); ms > 0) {
-            INFO("Loaded {} (actual: {}) songs in {}ms", levels.size(), actualCount, ms);
-        } else {
-            auto µs = (float)duration_cast<nanoseconds>(time).count() / 1000.0f;
-            INFO("Loaded {} (actual: {}) songs in {}us", levels.size(), actualCount, µs);
-        }
+        INFO("Refreshed root '{}' with {} songs in {}ms", partition.root.string(), (size_t)partition.levels.Count, duration_cast<milliseconds>(high_resolution_clock::now() - startTime).count());
+    }
 
-        // save cache to file after all songs are loaded
-        Utils::SaveSongInfoCache();
+    void RuntimeSongLoader::UpdateLevels_internal(RefreshRequest const& request) {
+        auto updateStartTime = high_resolution_clock::now();
 
-        // anonymous function to get the values from a songdict into a vector
-        static auto GetValues = [](SongDict* dict){
-            std::vector<CustomBeatmapLevel*> vec;
-            vec.reserve(dict->Count);
+        std::set<std::filesystem::path> loadPaths = request.levelPaths;
+        std::set<std::filesystem::path> unloadPaths = request.unloadPaths;
+        TrackExtraRoots(request);
 
-            auto enumerator = dict->GetEnumerator();
-            while(enumerator->i___System__Collections__IEnumerator()->MoveNext()) {
-                vec.emplace_back(enumerator->Current.Value);
-            }
-            enumerator->i___System__IDisposable()->Dispose();
+        // a root that is searched on its own loads what is new in it and unloads what vanished from it, the other roots are left alone
+        for (auto const& root : request.rootPaths) {
+            auto& partition = GetPartition(root, IsWipRoot(root));
 
-            return vec;
-        };
+            std::set<LevelPathAndWip> rootLevels;
+            CollectLevels(partition, rootLevels);
+            for (auto const& level : rootLevels) {
+                if (!partition.levels.Find(level.levelPath.string()) && !unloadPaths.contains(level.levelPath)) loadPaths.insert(level.levelPath);
+            }
+            partition.levels.ForEach([&rootLevels, &unloadPaths](std::string_view levelPath, CustomBeatmapLevel*) {
+                std::filesystem::path path(levelPath);
+                if (!rootLevels.contains(LevelPathAndWip{ path, false })) unloadPaths.insert(path);
+            });
+        }
 
-        auto collectionUpdateStartTime = high_resolution_clock::now();
+        std::vector<LevelPartition*> droppedPartitions;
+        for (auto const& root : request.unloadRootPaths) {
+            auto partition = FindPartition(root);
+            if (!partition) continue;
+
+            partition->levels.ForEach([&loadPaths, &unloadPaths](std::string_view levelPath, CustomBeatmapLevel*) {
+                std::filesystem::path path(levelPath);
+                loadPaths.erase(path);
+                unloadPaths.insert(path);
+            });
+            droppedPartitions.emplace_back(partition);
+        }
 
-        auto customLevelValues = GetValues(_customLevels);
-        auto customWIPLevelValues = GetValues(_customWIPLevels);
+        // take every requested level out of the partitions, the ones that should be loaded get loaded fresh below
+        std::vector<CustomBeatmapLevel*> removedLevels;
+        for (auto const& paths : { &loadPaths, &unloadPaths }) {
+            for (auto const& levelPath : *paths) {
+                if (auto level = RemoveLevel(levelPath.string())) removedLevels.emplace_back(level);
+            }
+        }
+        for (auto partition : droppedPartitions) DropPartition(partition);
 
-        _customLevelPack->SetLevels(customLevelValues);
-        _customLevelPack->SortLevels();
+        std::set<LevelPathAndWip> levels;
+        for (auto const& levelPath : loadPaths) {
+            if (HasInfoDat(levelPath)) {
+                auto& partition = GetPartitionFor(levelPath);
+                levels.emplace(levelPath, partition.isWip, &partition);
+            } else {
+                WARNING("Level load was requested for '{}' but it had no info.dat file! skipping...", levelPath.string());
+            }
+        }
 
-        _customWIPLevelPack->SetLevels(customWIPLevelValues);
-        _customWIPLevelPack->SortLevels();
+        // usually only a handful of levels, so they load on this thread
+        std::mutex levelsItrMutex;
+        std::set<LevelPathAndWip>::const_iterator levelsItr = levels.begin();
+        std::set<LevelPathAndWip>::const_iterator levelsEnd = levels.end();
+        _totalSongs = levels.size();
+        _loadedSongs = 0;
+        RefreshSongWorkerThread(&levelsItrMutex, &levelsItr, &levelsEnd);
 
-        {
-            std::vector<CustomBeatmapLevel*> allLevels;
-            allLevels.reserve(actualCount);
+        std::vector<CustomBeatmapLevel*> addedLevels;
+        std::vector<CustomBeatmapLevel*> addedWIPLevels;
+        for (auto const& [levelPath, isWip, partition] : levels) {
+            if (auto level = partition->levels.Find(levelPath.string())) {
+                (isWip ? addedWIPLevels : addedLevels).emplace_back(level);
+            }
+        }
 
-            // insert wip levels before other loaded levels
-            allLevels.insert(allLevels.begin(), customWIPLevelValues.begin(), customWIPLevelValues.end());
-            allLevels.insert(allLevels.begin(), customLevelValues.begin(), customLevelValues.end());
+        if (!levels.empty()) Utils::SaveSongInfoCache();
 
-            std::unordered_map<std::string, CustomBeatmapLevel*> levelIdsToLevels;
-            std::unordered_map<std::string, CustomBeatmapLevel*> hashesToLevels;
-            levelIdsToLevels.reserve(actualCount);
-            hashesToLevels.reserve(actualCount);
+        // the collections and packs are read from the main thread without locks, so they only ever change on it.
+        // emplace_back may reallocate _allLoadedLevels, which would pull spans out from under the readers otherwise
+        Utils::RunOnMainThread([&]() {
+            std::unordered_set<GlobalNamespace::BeatmapLevel*> removedSet(removedLevels.begin(), removedLevels.end());
+            if (!removedSet.empty()) {
+                std::erase_if(_allLoadedLevels, [&removedSet](CustomBeatmapLevel* level) { return removedSet.contains(level); });
+            }
 
-            for (auto const level : allLevels) {
+            for (auto const level : removedLevels) {
                 std::string levelID = lowerString(static_cast<std::string>(level->levelID));
 
-                levelIdsToLevels[levelID] = level;
-                hashesToLevels[std::string(GetHashFromLevelID(levelID))] = level;
+                // another level may have taken over the id or hash, that one stays
+                if (auto itr = _levelIdsToLevels.find(levelID); itr != _levelIdsToLevels.end() && itr->second == level) _levelIdsToLevels.erase(itr);
+                if (auto itr = _hashesToLevels.find(std::string(GetHashFromLevelID(levelID))); itr != _hashesToLevels.end() && itr->second == level) _hashesToLevels.erase(itr);
+                _levelIndex.Remove(level);
             }
 
-            // touch collections as short as possible by using move
-            _allLoadedLevels = std::move(allLevels);
-            _levelIdsToLevels = std::move(levelIdsToLevels);
-            _hashesToLevels = std::move(hashesToLevels);
-        }
+            for (auto const& added : { &addedLevels, &addedWIPLevels }) {
+                for (auto const level : *added) {
+                    std::string levelID = lowerString(static_cast<std::string>(level->levelID));
+
+                    _allLoadedLevels.emplace_back(level);
+                    _levelIdsToLevels[levelID] = level;
+                    _hashesToLevels[std::string(GetHashFromLevelID(levelID))] = level;
+                    _levelIndex.Add(level);
+                }
+            }
 
-        INFO("Updated collections after load in {}ms", duration_cast<milliseconds>(high_resolution_clock::now() - collectionUpdateStartTime).count());
+            // drop the removed levels from the packs and sort the added ones in, then pass only those changes on to the repositories
+            auto sortField = Utils::LevelSortFieldFromString(config.levelSortField).value_or(LevelSortField::SongName);
+            auto allLoaded = i2c::cast<SongLoader::CustomBeatmapLevelsRepository*>(_beatmapLevelsModel->_allLoadedBeatmapLevelsRepository);
+            auto UpdatePack = [this, allLoaded, &removedLevels, sortField](CustomLevelPack* pack, std::span<CustomBeatmapLevel* const> added) {
+                auto removed = pack->RemoveLevels(removedLevels);
+                pack->AddLevels(added, sortField);
+                if (removed.empty() && added.empty()) return false;
+
+                std::vector<GlobalNamespace::BeatmapLevel*> addedLevels(added.begin(), added.end());
+                for (auto repository : std::initializer_list<CustomBeatmapLevelsRepository*>{ _customBeatmapLevelsRepository, allLoaded }) {
+                    repository->RemoveLevels(pack, removed);
+                    repository->AddLevels(pack, addedLevels);
+                }
+                return true;
+            };
 
-        // events happen on main thread anyway so we don't have to queue up on main thread
-        RefreshLevelPacks();
+            bool packsChanged = UpdatePack(_customLevelPack, addedLevels);
+            packsChanged |= UpdatePack(_customWIPLevelPack, addedWIPLevels);
 
-        // same goes here, it's already on main thread
-        InvokeSongsLoaded(_allLoadedLevels);
-        _areSongsLoaded = true;
-        INFO("Refresh performed in {}ms", duration_cast<milliseconds>(high_resolution_clock::now() - refreshStartTime).count());
+            if (packsChanged) InvokeCustomLevelPacksRefreshed(_customBeatmapLevelsRepository);
+
+            for (auto const level : removedLevels) InvokeLevelRemoved(level);
+            for (auto const& added : { &addedLevels, &addedWIPLevels }) {
+                for (auto const level : *added) InvokeLevelAdded(level);
+            }
+        }).get();
+
+        INFO("Updated {} levels in {}ms", loadPaths.size() + unloadPaths.size(), duration_cast<milliseconds>(high_resolution_clock::now() - updateStartTime).count());
     }
 
     void RuntimeSongLoader::RefreshSongWorkerThread(std::mutex* levelsItrMutex, std::set<LevelPathAndWip>::const_iterator* levelsItr, std::set<LevelPathAndWip>::const_iterator* levelsEnd) {
@@ -300,7 +725,7 @@ namespace SongCore::SongLoader {
         };
 
         while (*levelsItr != *levelsEnd) {
-            auto [levelPath, isWip] = NextLevel(*levelsItrMutex, *levelsItr, *levelsEnd);
+            auto [levelPath, isWip, partition] = NextLevel(*levelsItrMutex, *levelsItr, *levelsEnd);
 
             // we got an invalid levelPath
             if (levelPath.empty()) {
@@ -310,17 +735,13 @@ namespace SongCore::SongLoader {
 
             try {
                 auto startTime = high_resolution_clock::now();
-                CustomBeatmapLevel* level = nullptr;
-                StringW csLevelPath(levelPath.string());
+                auto pathString = levelPath.string();
 
-                // pick the dictionary we need to add / check from based on whether this song is WIP
-                auto targetDict = isWip ? _customWIPLevels : _customLevels;
+                // the partition of the root the level was found in is the registry we add to / check from
+                auto& targetRegistry = partition->levels;
 
-                // preliminary check to see whether the song we are looking for already is in our dictionary
-                bool containsKey = targetDict->ContainsKey(csLevelPath);
-                if (containsKey) {
-                    level = targetDict->get_Item(levelPath.string());
-                }
+                // preliminary check to see whether the song we are looking for already is in our registry
+                CustomBeatmapLevel* level = targetRegistry.Find(pathString);
 
                 // if the level is not yet set, attempt loading levelinfosavedata from the song path, then load custom preview beatmap level from that
                 if (!level) {
@@ -347,9 +768,9 @@ namespace SongCore::SongLoader {
                     }
                 }
 
-                // if we now have a level, add it to the target dictionary, else log a failure
+                // if we now have a level, add it to the target registry, else log a failure
                 if (level) {
-                    targetDict->TryAdd(levelPath.string(), level);
+                    targetRegistry.TryAdd(pathString, level);
                 } else {
                     WARNING("Somehow failed to load song at path {}", levelPath.string());
                 }
@@ -378,48 +799,57 @@ namespace SongCore::SongLoader {
 
     void RuntimeSongLoader::RefreshLevelPacks() {
         auto allLoaded = i2c::cast<SongLoader::CustomBeatmapLevelsRepository*>(_beatmapLevelsModel->_allLoadedBeatmapLevelsRepository);
-        for (auto pack : _customBeatmapLevelsRepository->BeatmapLevelPacks) {
-            allLoaded->RemoveLevelPack(pack);
+        auto previousPacks = _customBeatmapLevelsRepository->BeatmapLevelPacks;
+        std::vector<GlobalNamespace::BeatmapLevelPack*> previous(previousPacks.begin(), previousPacks.end());
+
+        // packs other than ours get added again by their owners during CustomLevelPacksWillRefresh
+        for (auto pack : previous) {
+            if (pack != _customLevelPack && pack != _customWIPLevelPack) _customBeatmapLevelsRepository->RemoveLevelPack(pack);
         }
-        _customBeatmapLevelsRepository->ClearLevelPacks();
 
-        _customBeatmapLevelsRepository->AddLevelPack(_customLevelPack);
-        _customBeatmapLevelsRepository->AddLevelPack(_customWIPLevelPack);
+        // our packs stay added, so only the levels that changed since the last refresh get touched
+        for (auto pack : { _customLevelPack, _customWIPLevelPack }) {
+            if (_customBeatmapLevelsRepository->HasLevelPack(pack)) _customBeatmapLevelsRepository->UpdateLevelPack(pack);
+            else _customBeatmapLevelsRepository->AddLevelPack(pack);
+        }
 
         InvokeCustomLevelPacksWillRefresh(_customBeatmapLevelsRepository);
 
-        _customBeatmapLevelsRepository->FixBackingDictionaries();
-
-        for (auto pack : _customBeatmapLevelsRepository->BeatmapLevelPacks) {
-            allLoaded->AddLevelPack(pack);
+        // the game's own packs in allLoaded are left alone, ours are diffed against what it had before
+        auto currentPacks = _customBeatmapLevelsRepository->BeatmapLevelPacks;
+        for (auto pack : previous) {
+            if (std::find(currentPacks.begin(), currentPacks.end(), pack) == currentPacks.end() && allLoaded->HasLevelPack(pack)) allLoaded->RemoveLevelPack(pack);
         }
 
-        allLoaded->FixBackingDictionaries();
+        for (auto pack : currentPacks) {
+            if (allLoaded->HasLevelPack(pack)) allLoaded->UpdateLevelPack(pack);
+            else allLoaded->AddLevelPack(pack);
+        }
 
         InvokeCustomLevelPacksRefreshed(_customBeatmapLevelsRepository);
     }
 
-    void RuntimeSongLoader::DeleteSong_internal(std::filesystem::path levelPath) {
-        INFO("Deleting song @ path {}", levelPath.string());
-        auto csPath = StringW(levelPath.string());
-        SongDict* targetDict = nullptr;
+    void RuntimeSongLoader::SortLevels(LevelSortField field) {
+        auto startTime = high_resolution_clock::now();
 
-        CustomBeatmapLevel* level = nullptr;
+        _customLevelPack->SortLevels(field);
+        _customWIPLevelPack->SortLevels(field);
 
-        if (CustomLevels->ContainsKey(csPath)) {
-            targetDict = CustomLevels;
-            level = CustomLevels->get_Item(csPath);
-        } else if (CustomWIPLevels->ContainsKey(csPath)) {
-            targetDict = CustomWIPLevels;
-            level = CustomWIPLevels->get_Item(csPath);
-        }
+        INFO("Sorted levels by {} in {}us", Utils::LevelSortFieldToString(field), duration_cast<microseconds>(high_resolution_clock::now() - startTime).count());
 
-        if (!targetDict) {
-            WARNING("Level with path {} was attempted to be deleted, but it couldn't be found in the songloader dictionaries! returning...", levelPath.string());
-            return;
-        } else if (!level) {
-            WARNING("Somehow the stored beatmap level was null, just removing from the dictionary and nothing else...");
-            targetDict->System_Collections_Generic_IDictionary_TKey_TValue__Remove(csPath);
+        RefreshLevelPacks();
+    }
+
+    void RuntimeSongLoader::DeleteSong_internal(std::filesystem::path levelPath, std::shared_ptr<std::promise<void>> deleted) {
+        INFO("Deleting song @ path {}", levelPath.string());
+        auto pathString = levelPath.string();
+
+        // the partitions never hold null levels
+        CustomBeatmapLevel* level = FindLevel(pathString);
+
+        if (!level) {
+            WARNING("Level with path {} was attempted to be deleted, but it couldn't be found in the songloader partitions! returning...", levelPath.string());
+            deleted->set_value();
             return;
         }
 
@@ -430,18 +860,28 @@ namespace SongCore::SongLoader {
         std::filesystem::remove_all(levelPath, error_code);
 
         if (error_code) WARNING("Error occurred during removal of {}: {}", levelPath.string(), error_code.message());
-        if (!targetDict->System_Collections_Generic_IDictionary_TKey_TValue__Remove(csPath)) WARNING("Failed to remove beatmap for {} from dictionary!", levelPath.string());
-
-        // since a (soft) refresh is required after a reload, there's no need to remove from the c++ collections
-        // like _allLoadedLevels, _levelIdsToLevels, _hashesToLevels
 
-        bool deletedInvoked = false;
-        // let consumers of our api know a song was deleted
-        InvokeSongDeleted();
+        // unload through the refresh passes so every collection and pack drops the level in place.
+        // this job must not block on the pass, so the rest happens once the refreshes completed
+        QueueRefresh([&levelPath](RefreshRequest& request) { request.Unload(levelPath); });
+        OnRefreshCompleted([this, deleted]() {
+            // let consumers of our api know a song was deleted
+            InvokeSongDeleted();
+            deleted->set_value();
+        });
     }
 
     std::future<void> RuntimeSongLoader::DeleteSong(std::filesystem::path const& levelPath) {
-        return il2cpp_async(&RuntimeSongLoader::DeleteSong_internal, this, levelPath);
+        auto deleted = std::make_shared<std::promise<void>>();
+        auto future = deleted->get_future();
+        Utils::ThreadPool::Get().Enqueue([this, levelPath, deleted](){
+            try {
+                DeleteSong_internal(levelPath, deleted);
+            } catch (...) {
+                deleted->set_exception(std::current_exception());
+            }
+        }, Utils::ThreadPool::Lane::Background);
+        return future;
     }
 
     std::future<void> RuntimeSongLoader::DeleteSong(CustomBeatmapLevel* beatmapLevel) {
@@ -450,11 +890,9 @@ namespace SongCore::SongLoader {
     }
 
     CustomBeatmapLevel* RuntimeSongLoader::GetLevelByPath(std::filesystem::path const& levelPath) {
-        auto csPath = StringW(levelPath.string());
+        auto pathString = levelPath.string();
 
-        CustomBeatmapLevel* level = nullptr;
-        if (CustomLevels->TryGetValue(csPath, by_ref(level))) return level;
-        else if (CustomWIPLevels->TryGetValue(csPath, by_ref(level))) return level;
+        if (auto level = FindLevel(pathString)) return level;
 
         return GetLevelByFunction([path = levelPath.string()](auto level){ return level->customLevelPath == path; });
     }
@@ -500,16 +938,23 @@ namespace SongCore::SongLoader {
         return levelid.substr(0, levelid.find(u' '));
     }
 
-// macro to wrap an event invoke into something that always executes on main thread. could we just check whether we are on main thread and invoke in place? sure, but where's the fun in that!
-#define EVENT_MAIN_THREAD_INVOKE_WRAPPER(event, ...) do { \
-    bool eventInvoked = false; \
-    BSML::MainThreadScheduler::Schedule([this, &eventInvoked __VA_OPT__(, __VA_ARGS__)](){ \
-        event.invoke(__VA_ARGS__); \
-        SongCore::API::Loading::Get##event##Event().invoke(__VA_ARGS__); \
-        eventInvoked = true; \
-    }); \
-    while (!eventInvoked) std::this_thread::sleep_for(std::chrono::milliseconds(10)); \
-} while (0)
+    /// @brief runs the event invoke on the main thread, in place when already on it. blocks until it ran so refresh steps stay ordered,
+    /// and a throwing handler gets logged instead of taking the refresh down with it
+    static void RunEventOnMainThread(char const* eventName, std::function<void()> invoke) {
+        try {
+            Utils::RunOnMainThread(std::move(invoke)).get();
+        } catch (std::exception const& e) {
+            ERROR("Caught exception of type {} in a {} handler, what: {}", typeid(e).name(), eventName, e.what());
+        } catch (...) {
+            ERROR("Caught exception of unknown type in a {} handler", eventName);
+        }
+    }
+
+// macro to wrap an event invoke into something that always executes on main thread
+#define EVENT_MAIN_THREAD_INVOKE_WRAPPER(event, ...) RunEventOnMainThread(#event, [this __VA_OPT__(, __VA_ARGS__)](){ \
+    event.invoke(__VA_ARGS__); \
+    SongCore::API::Loading::Get##event##Event().invoke(__VA_ARGS__); \
+})
 
     void RuntimeSongLoader::InvokeSongsWillRefresh() const {
         EVENT_MAIN_THREAD_INVOKE_WRAPPER(SongsWillRefresh);
@@ -534,4 +979,12 @@ namespace SongCore::SongLoader {
     void RuntimeSongLoader::InvokeSongDeleted() const {
         EVENT_MAIN_THREAD_INVOKE_WRAPPER(SongDeleted);
     }
+
+    void RuntimeSongLoader::InvokeLevelAdded(CustomBeatmapLevel* level) const {
+        EVENT_MAIN_THREAD_INVOKE_WRAPPER(LevelAdded, level);
+    }
+
+    void RuntimeSongLoader::InvokeLevelRemoved(CustomBeatmapLevel* level) const {
+        EVENT_MAIN_THREAD_INVOKE_WRAPPER(LevelRemoved, level);
+    }
 }
@@ -69,14 +69,15 @@ namespace SongCore::UI {
     }
 
     void ColorsOptions::SetColors(CustomJSONData::CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails::CustomColors const& colors) {
+        using CustomColors = CustomJSONData::CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails::CustomColors;
         _colorSchemeView->SetColors(
-            colors.colorLeft.value_or(_voidColor),
-            colors.colorRight.value_or(_voidColor),
-            colors.envColorLeft.value_or(_voidColor),
-            colors.envColorRight.value_or(_voidColor),
-            colors.envColorLeftBoost.value_or(_voidColor),
-            colors.envColorRightBoost.value_or(_voidColor),
-            colors.obstacleColor.value_or(_voidColor)
+            colors.Get(CustomColors::ColorLeft, _voidColor),
+            colors.Get(CustomColors::ColorRight, _voidColor),
+            colors.Get(CustomColors::EnvColorLeft, _voidColor),
+            colors.Get(CustomColors::EnvColorRight, _voidColor),
+            colors.Get(CustomColors::EnvColorLeftBoost, _voidColor),
+            colors.Get(CustomColors::EnvColorRightBoost, _voidColor),
+            colors.Get(CustomColors::ObstacleColor, _voidColor)
         );
     }
 }
@@ -1,9 +1,9 @@
 #include "UI/IconCache.hpp"
+#include "Utils/File.hpp"
 #include "assets.hpp"
 #include "logging.hpp"
 #include "bsml/shared/Helpers/utilities.hpp"
-#include <fstream>
-#include <ios>
+#include <algorithm>
 
 DEFINE_TYPE(SongCore::UI, IconCache);
 
@@ -66,13 +66,10 @@ namespace SongCore::UI {
         }
 
         // wasn't loaded -> load
-        if (std::filesystem::exists(path)) {
-            std::ifstream in(path, std::ios::in | std::ios::binary | std::ios::ate);
-
-            il2cpp_array_size_t len = in.tellg();
-            in.seekg(0, std::ios::beg);
-            ArrayW<uint8_t> data(len);
-            in.read((char*)data.begin(), len);
+        if (auto file = Utils::FileView::Open(path)) {
+            auto bytes = file->bytes();
+            ArrayW<uint8_t> data(il2cpp_array_size_t(bytes.size()));
+            std::copy(bytes.begin(), bytes.end(), data.begin());
             sprite = BSML::Utilities::LoadSpriteRaw(data);
 
             _pathIcons->Add(csPath, sprite);
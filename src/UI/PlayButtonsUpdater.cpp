@@ -83,13 +83,9 @@ namespace SongCore::UI {
         _levelIsWIP = eventArgs.isWIP;
 
         _missingRequirements = false;
-        if (eventArgs.customLevelDetails.has_value()) {
-            for (auto& requirement : eventArgs.customLevelDetails->difficultyDetails.requirements) {
-                if (!_capabilities->IsCapabilityRegistered(requirement)) {
-                    _missingRequirements = true;
-                    break;
-                }
-            }
+        if (eventArgs.isCustom && eventArgs.customLevelDetails.has_value()) {
+            auto const& difficultyDetails = eventArgs.customLevelDetails->difficultyDetails;
+            _missingRequirements = !_capabilities->AreRequirementsMet(eventArgs.customBeatmapLevel, difficultyDetails.characteristicName, difficultyDetails.difficulty);
         }
 
         UpdatePlayButtonsState();
@@ -110,7 +110,7 @@ namespace SongCore::UI {
 
             bool installed = _capabilities->IsCapabilityRegistered(requirement);
             auto cell = GetCellInfo();
-            cell->text = fmt::format("<size=75%>{}", requirement);
+            cell->text = fmt::format("<size=75%>{}", requirement.view());
             cell->subText = installed ? RequirementFound : RequirementMissing;
             cell->icon = installed ? _iconCache->HaveReqIcon : _iconCache->MissingReqIcon;
             _levelInfoCells.push_back(cell);
@@ -119,8 +119,8 @@ namespace SongCore::UI {
         for (auto& contributor : levelDetails.contributors) {
             auto cell = GetCellInfo();
 
-            cell->text = fmt::format("<size=75%>{}", contributor.name);
-            cell->subText = contributor.role;
+            cell->text = fmt::format("<size=75%>{}", contributor.name.view());
+            cell->subText = contributor.role.view();
             UnityEngine::Sprite* icon = nullptr;
             if (!contributor.iconPath.empty()) {
                 std::filesystem::path levelPath(eventArgs.customBeatmapLevel->customLevelPath);
@@ -159,7 +159,7 @@ namespace SongCore::UI {
             static ConstString Warning("Warning");
 
             auto cell = GetCellInfo();
-            cell->text = fmt::format("<size=75%>{}", warning);
+            cell->text = fmt::format("<size=75%>{}", warning.view());
             cell->subText = Warning;
             cell->icon = _iconCache->WarningIcon;
             _levelInfoCells.push_back(cell);
@@ -169,7 +169,7 @@ namespace SongCore::UI {
             static ConstString Info("Info");
 
             auto cell = GetCellInfo();
-            cell->text = fmt::format("<size=75%>{}", information);
+            cell->text = fmt::format("<size=75%>{}", information.view());
             cell->subText = Info;
             cell->icon = _iconCache->InfoIcon;
             _levelInfoCells.push_back(cell);
@@ -181,7 +181,7 @@ namespace SongCore::UI {
 
             bool installed = _capabilities->IsCapabilityRegistered(suggestion);
             auto cell = GetCellInfo();
-            cell->text = suggestion;
+            cell->text = suggestion.view();
             cell->subText = installed ? SuggestionFound : SuggestionMissing;
             cell->icon = installed ? _iconCache->HaveSuggestionIcon : _iconCache->MissingSuggestionIcon;
             _levelInfoCells.push_back(cell);
@@ -4,14 +4,195 @@
 #include "Utils/File.hpp"
 #include "logging.hpp"
 
+#include <array>
 #include <filesystem>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
+#include <vector>
 #include <unordered_map>
 #include <fstream>
 
-#include "paper2_scotland2/shared/utfcpp/source/utf8.h"
-
 namespace SongCore::Utils {
+    using LevelDetails = CustomJSONData::CustomSaveDataInfo::BasicCustomLevelDetails;
+    using DifficultyDetails = CustomJSONData::CustomSaveDataInfo::BasicCustomDifficultyBeatmapDetails;
+    using CustomColors = DifficultyDetails::CustomColors;
+
+    /// @brief version of the cached level details, bumped whenever what gets written changes so older entries get parsed again
+    static constexpr int LevelDetailsCacheVersion = 2;
+
+    static rapidjson::Value SerializeString(std::string_view str, rapidjson::Document::AllocatorType& allocator) {
+        return rapidjson::Value(str.data(), str.size(), allocator);
+    }
+
+    static void AddOptionalString(rapidjson::Value& obj, char const* name, std::optional<std::string> const& str, rapidjson::Document::AllocatorType& allocator) {
+        if (str.has_value()) obj.AddMember(rapidjson::StringRef(name), SerializeString(*str, allocator), allocator);
+    }
+
+    static void AddStrings(rapidjson::Value& obj, char const* name, std::vector<InternedString> const& strings, rapidjson::Document::AllocatorType& allocator) {
+        if (strings.empty()) return;
+        rapidjson::Value arr(rapidjson::kArrayType);
+        for (auto const& str : strings) arr.PushBack(SerializeString(str.view(), allocator), allocator);
+        obj.AddMember(rapidjson::StringRef(name), arr, allocator);
+    }
+
+    static rapidjson::Value SerializeDifficultyDetails(GlobalNamespace::BeatmapDifficulty difficulty, DifficultyDetails const& details, rapidjson::Document::AllocatorType& allocator) {
+        rapidjson::Value val(rapidjson::kObjectType);
+        val.AddMember("difficulty", static_cast<int>(difficulty), allocator);
+        AddStrings(val, "requirements", details.requirements, allocator);
+        AddStrings(val, "suggestions", details.suggestions, allocator);
+        AddStrings(val, "warnings", details.warnings, allocator);
+        AddStrings(val, "information", details.information, allocator);
+        AddOptionalString(val, "customDiffName", details.customDiffName, allocator);
+        AddOptionalString(val, "customDiffLabel", details.customDiffLabel, allocator);
+        AddOptionalString(val, "environmentType", details.environmentType, allocator);
+        if (details.oneSaber.has_value()) val.AddMember("oneSaber", *details.oneSaber, allocator);
+        if (details.showRotationNoteSpawnLines.has_value()) val.AddMember("showRotationNoteSpawnLines", *details.showRotationNoteSpawnLines, allocator);
+
+        if (details.customColors.has_value()) {
+            auto const& customColors = *details.customColors;
+            // only the colors that are set get written, in slot order
+            rapidjson::Value colors(rapidjson::kArrayType);
+            for (uint8_t slot = 0; slot < CustomColors::SlotCount; slot++) {
+                if (!customColors.Has(CustomColors::Slot(slot))) continue;
+                auto const& color = customColors.colors[slot];
+                colors.PushBack(color.r, allocator).PushBack(color.g, allocator).PushBack(color.b, allocator).PushBack(color.a, allocator);
+            }
+            val.AddMember("colorMask", static_cast<unsigned>(customColors.presentMask), allocator);
+            val.AddMember("colors", colors, allocator);
+        }
+
+        return val;
+    }
+
+    static rapidjson::Value SerializeLevelDetails(LevelDetails const& details, rapidjson::Document::AllocatorType& allocator) {
+        rapidjson::Value val(rapidjson::kObjectType);
+        val.AddMember("version", LevelDetailsCacheVersion, allocator);
+
+        rapidjson::Value characteristics(rapidjson::kArrayType);
+        for (auto const& [characteristicName, detailsSet] : details.characteristicNameToBeatmapDetailsSet) {
+            rapidjson::Value set(rapidjson::kObjectType);
+            set.AddMember("name", SerializeString(characteristicName.view(), allocator), allocator);
+            AddOptionalString(set, "label", detailsSet.characteristicLabel, allocator);
+            AddOptionalString(set, "iconPath", detailsSet.characteristicIconImageFileName, allocator);
+
+            rapidjson::Value difficulties(rapidjson::kArrayType);
+            for (auto const& [difficulty, difficultyDetails] : detailsSet.difficultyToDifficultyBeatmapDetails) {
+                // the table key is what the difficulty is stored under, the details don't always carry it
+                difficulties.PushBack(SerializeDifficultyDetails(difficulty, difficultyDetails, allocator), allocator);
+            }
+            set.AddMember("difficulties", difficulties, allocator);
+            characteristics.PushBack(set, allocator);
+        }
+        val.AddMember("characteristics", characteristics, allocator);
+
+        rapidjson::Value contributors(rapidjson::kArrayType);
+        for (auto const& contributor : details.contributors) {
+            rapidjson::Value entry(rapidjson::kObjectType);
+            entry.AddMember("name", SerializeString(contributor.name.view(), allocator), allocator);
+            entry.AddMember("role", SerializeString(contributor.role.view(), allocator), allocator);
+            entry.AddMember("iconPath", SerializeString(contributor.iconPath.string(), allocator), allocator);
+            contributors.PushBack(entry, allocator);
+        }
+        val.AddMember("contributors", contributors, allocator);
+
+        return val;
+    }
+
+    static std::optional<std::string> GetOptionalString(rapidjson::Value const& obj, char const* name) {
+        auto itr = obj.FindMember(name);
+        if (itr == obj.MemberEnd() || !itr->value.IsString()) return std::nullopt;
+        return std::string(itr->value.GetString(), itr->value.GetStringLength());
+    }
+
+    static void GetStrings(rapidjson::Value const& obj, char const* name, std::vector<InternedString>& out) {
+        auto itr = obj.FindMember(name);
+        if (itr == obj.MemberEnd() || !itr->value.IsArray()) return;
+        out.reserve(itr->value.Size());
+        for (auto const& str : itr->value.GetArray()) {
+            if (str.IsString()) out.emplace_back(std::string_view(str.GetString(), str.GetStringLength()));
+        }
+    }
+
+    static std::optional<bool> GetOptionalBool(rapidjson::Value const& obj, char const* name) {
+        auto itr = obj.FindMember(name);
+        if (itr == obj.MemberEnd() || !itr->value.IsBool()) return std::nullopt;
+        return itr->value.GetBool();
+    }
+
+    static bool DeserializeDifficultyDetails(rapidjson::Value const& value, InternedString characteristicName, DifficultyDetails& details) {
+        auto difficultyItr = value.FindMember("difficulty");
+        if (difficultyItr == value.MemberEnd() || !difficultyItr->value.IsInt()) return false;
+
+        details.characteristicName = characteristicName;
+        details.difficulty = GlobalNamespace::BeatmapDifficulty(static_cast<GlobalNamespace::BeatmapDifficulty::__BeatmapDifficulty_Unwrapped>(difficultyItr->value.GetInt()));
+        GetStrings(value, "requirements", details.requirements);
+        GetStrings(value, "suggestions", details.suggestions);
+        GetStrings(value, "warnings", details.warnings);
+        GetStrings(value, "information", details.information);
+        details.customDiffName = GetOptionalString(value, "customDiffName");
+        details.customDiffLabel = GetOptionalString(value, "customDiffLabel");
+        details.environmentType = GetOptionalString(value, "environmentType");
+        details.oneSaber = GetOptionalBool(value, "oneSaber");
+        details.showRotationNoteSpawnLines = GetOptionalBool(value, "showRotationNoteSpawnLines");
+
+        auto colorMaskItr = value.FindMember("colorMask");
+        auto colorsItr = value.FindMember("colors");
+        if (colorMaskItr != value.MemberEnd() && colorMaskItr->value.IsUint() && colorsItr != value.MemberEnd() && colorsItr->value.IsArray()) {
+            auto const& colors = colorsItr->value;
+            auto& customColors = details.customColors.emplace();
+            rapidjson::SizeType idx = 0;
+            for (uint8_t slot = 0; slot < CustomColors::SlotCount; slot++) {
+                if (!(colorMaskItr->value.GetUint() & (1 << slot))) continue;
+                if (idx + 4 > colors.Size()) return false;
+                customColors.Set(CustomColors::Slot(slot), UnityEngine::Color(colors[idx].GetFloat(), colors[idx + 1].GetFloat(), colors[idx + 2].GetFloat(), colors[idx + 3].GetFloat()));
+                idx += 4;
+            }
+        }
+
+        return true;
+    }
+
+    static std::shared_ptr<LevelDetails const> DeserializeLevelDetails(rapidjson::Value const& value) {
+        auto versionItr = value.FindMember("version");
+        if (versionItr == value.MemberEnd() || !versionItr->value.IsInt() || versionItr->value.GetInt() != LevelDetailsCacheVersion) return nullptr;
+
+        auto details = std::make_shared<LevelDetails>();
+
+        auto characteristicsItr = value.FindMember("characteristics");
+        if (characteristicsItr == value.MemberEnd() || !characteristicsItr->value.IsArray()) return nullptr;
+        for (auto const& set : characteristicsItr->value.GetArray()) {
+            auto nameItr = set.FindMember("name");
+            if (nameItr == set.MemberEnd() || !nameItr->value.IsString()) return nullptr;
+            InternedString characteristicName(std::string_view(nameItr->value.GetString(), nameItr->value.GetStringLength()));
+
+            auto& detailsSet = details->characteristicNameToBeatmapDetailsSet[characteristicName];
+            detailsSet.characteristicName = characteristicName;
+            detailsSet.characteristicLabel = GetOptionalString(set, "label");
+            detailsSet.characteristicIconImageFileName = GetOptionalString(set, "iconPath");
+
+            auto difficultiesItr = set.FindMember("difficulties");
+            if (difficultiesItr == set.MemberEnd() || !difficultiesItr->value.IsArray()) continue;
+            for (auto const& difficulty : difficultiesItr->value.GetArray()) {
+                DifficultyDetails difficultyDetails;
+                if (!DeserializeDifficultyDetails(difficulty, characteristicName, difficultyDetails)) return nullptr;
+                detailsSet.difficultyToDifficultyBeatmapDetails[difficultyDetails.difficulty] = std::move(difficultyDetails);
+            }
+        }
+
+        auto contributorsItr = value.FindMember("contributors");
+        if (contributorsItr != value.MemberEnd() && contributorsItr->value.IsArray()) {
+            for (auto const& entry : contributorsItr->value.GetArray()) {
+                auto& contributor = details->contributors.emplace_back();
+                contributor.name = InternedString(GetOptionalString(entry, "name").value_or(""));
+                contributor.role = InternedString(GetOptionalString(entry, "role").value_or(""));
+                contributor.iconPath = GetOptionalString(entry, "iconPath").value_or("");
+            }
+        }
+
+        return details;
+    }
+
     rapidjson::Value CachedSongData::Serialize(rapidjson::Document::AllocatorType& allocator) const {
         rapidjson::Value val;
         val.SetObject();
@@ -19,6 +200,7 @@ namespace SongCore::Utils {
         val.AddMember("directoryHash", directoryHash, allocator);
         if (sha1.has_value()) val.AddMember("sha1", rapidjson::Value(sha1->c_str(), sha1->size(), allocator), allocator);
         if (songDuration.has_value()) val.AddMember("songDuration", songDuration.value(), allocator);
+        if (levelDetails) val.AddMember("levelDetails", SerializeLevelDetails(*levelDetails, allocator), allocator);
 
         return val;
     }
@@ -43,13 +225,28 @@ namespace SongCore::Utils {
             songDuration = songDurationItr->value.GetFloat();
         } // optional so foundEverything unaffected
 
+        auto levelDetailsItr = value.FindMember("levelDetails");
+        if (levelDetailsItr != memberEnd && levelDetailsItr->value.IsObject()) {
+            levelDetails = DeserializeLevelDetails(levelDetailsItr->value);
+        } // optional so foundEverything unaffected
+
         return foundEverything;
     }
 
-    static std::shared_mutex _cacheMutex;
-    static std::unordered_map<std::string, CachedSongData> _cachedSongData;
+    /// @brief the cache is split by path hash, so the roots that load in parallel don't all queue up on one lock
+    struct CacheShard {
+        std::shared_mutex mutex;
+        std::unordered_map<std::string, CachedSongData> songData;
+    };
+
+    static constexpr size_t CacheShardCount = 16;
+    static std::array<CacheShard, CacheShardCount> _cacheShards;
     static std::filesystem::path _cachePath = "/sdcard/ModData/com.beatgames.beatsaber/Mods/SongCore/CachedSongData.json";
 
+    static CacheShard& GetCacheShard(std::string const& levelPath) {
+        return _cacheShards[std::hash<std::string>{}(levelPath) % CacheShardCount];
+    }
+
     std::optional<CachedSongData> GetCachedInfo(std::filesystem::path const& levelPath) {
         auto dirHashOpt = Utils::GetDirectoryHash(levelPath);
         if (!dirHashOpt.has_value()) {
@@ -58,10 +255,12 @@ namespace SongCore::Utils {
         }
 
         auto directoryHash = *dirHashOpt;
-        std::shared_lock<std::shared_mutex> lock(_cacheMutex);
-        auto itr = _cachedSongData.find(levelPath);
+        auto pathString = levelPath.string();
+        auto& shard = GetCacheShard(pathString);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto itr = shard.songData.find(pathString);
         // if found and dir hash matches, we found a correct value
-        if (itr != _cachedSongData.end() && itr->second.directoryHash == directoryHash) return itr->second;
+        if (itr != shard.songData.end() && itr->second.directoryHash == directoryHash) return itr->second;
         lock.unlock();
 
         // make a new entry and set it in the map, and then return that
@@ -72,23 +271,25 @@ namespace SongCore::Utils {
     }
 
     void SetCachedInfo(std::filesystem::path const& levelPath, CachedSongData const& newInfo) {
-        std::unique_lock<std::shared_mutex> lock(_cacheMutex);
-        _cachedSongData[levelPath] = newInfo;
+        auto pathString = levelPath.string();
+        auto& shard = GetCacheShard(pathString);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.songData[pathString] = newInfo;
     }
 
     void RemoveCachedInfo(std::filesystem::path const& levelPath) {
-        std::shared_lock<std::shared_mutex> shared_lock(_cacheMutex);
-        auto itr = _cachedSongData.find(levelPath);
-        if (itr == _cachedSongData.end()) return;
-        shared_lock.unlock();
-
-        std::unique_lock<std::shared_mutex> unique_lock(_cacheMutex);
-        _cachedSongData.erase(itr);
+        auto pathString = levelPath.string();
+        auto& shard = GetCacheShard(pathString);
+        // erase under the unique lock only, an iterator found under a shared lock may be stale by the time it is upgraded
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.songData.erase(pathString);
     }
 
     void ClearSongInfoCache() {
-        std::unique_lock<std::shared_mutex> lock(_cacheMutex);
-        _cachedSongData.clear();
+        for (auto& shard : _cacheShards) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.songData.clear();
+        }
     }
 
     void SaveSongInfoCache() {
@@ -96,15 +297,16 @@ namespace SongCore::Utils {
         doc.SetObject();
         auto& allocator = doc.GetAllocator();
 
-        std::shared_lock<std::shared_mutex> lock(_cacheMutex);
-        for (auto& [levelPath, data] : _cachedSongData) {
-            // skip saving levels that no longer exist
-            if (!std::filesystem::exists(levelPath)) continue;
+        for (auto& shard : _cacheShards) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (auto& [levelPath, data] : shard.songData) {
+                // skip saving levels that no longer exist
+                if (!std::filesystem::exists(levelPath)) continue;
 
-            rapidjson::Value memberName(levelPath.c_str(), levelPath.size(), allocator);
-            doc.AddMember(memberName, data.Serialize(allocator), allocator);
+                rapidjson::Value memberName(levelPath.c_str(), levelPath.size(), allocator);
+                doc.AddMember(memberName, data.Serialize(allocator), allocator);
+            }
         }
-        lock.unlock();
 
         rapidjson::StringBuffer buff;
         rapidjson::Writer writer(buff);
@@ -120,25 +322,29 @@ namespace SongCore::Utils {
         if (!std::filesystem::exists(_cachePath)) return false;
 
         bool foundEverything = true;
-        auto text = utf8::utf16to8(ReadText(_cachePath));
+        // the cache is always written as utf8, so it's parsed straight from the file
+        auto file = FileView::Open(_cachePath);
+        if (!file) return false;
+        auto text = file->chars();
 
         rapidjson::Document doc;
-        doc.Parse(text);
+        doc.Parse(text.data(), text.size());
         if (doc.HasParseError()) {
             Utils::PrintJSONError<rapidjson::UTF8<>>(doc, "loading song info cache", text);
             return false;
         }
         auto memberEnd = doc.MemberEnd();
 
-        std::unique_lock<std::shared_mutex> lock(_cacheMutex);
-        _cachedSongData.clear();
+        ClearSongInfoCache();
         for (auto itr = doc.MemberBegin(); itr != memberEnd; itr++) {
-            std::filesystem::path levelPath = itr->name.Get<std::string>();
+            auto levelPath = itr->name.Get<std::string>();
             // skip levels that no longer exist
             if (!std::filesystem::exists(levelPath)) continue;
-            if (!_cachedSongData[levelPath].Deserialize(itr->value)) foundEverything = false;
+
+            auto& shard = GetCacheShard(levelPath);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            if (!shard.songData[levelPath].Deserialize(itr->value)) foundEverything = false;
         }
-        lock.unlock();
 
         return foundEverything;
     }
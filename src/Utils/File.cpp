@@ -1,15 +1,23 @@
 #include "Utils/File.hpp"
 #include "logging.hpp"
 
-#include "beatsaber-hook/shared/utils.hpp"
+#include "paper2_scotland2/shared/utfcpp/source/utf8.h"
+
+#include <cerrno>
+#include <cstring>
 #include <filesystem>
 #include <iterator>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <utility>
 #include <vector>
-#include <filesystem>
-#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace SongCore::Utils {
     std::vector<std::filesystem::path> GetFolders(std::filesystem::path path) {
@@ -48,36 +56,177 @@ namespace SongCore::Utils {
         return dirs;
     }
 
-    std::u16string ReadText(std::string_view path){
-        if(!fileexists(path))
-            return u"";
-        std::basic_ifstream<char16_t> fileStream(path.data(), std::ifstream::in);
-        if(!fileStream.is_open())
-            return u"";
-        std::u16string text((std::istreambuf_iterator<char16_t>(fileStream)), std::istreambuf_iterator<char16_t>());
+    /// @brief small file buffers are handed back here so loading many levels doesn't allocate a buffer per file
+    static constexpr size_t MaxPooledBuffers = 8;
+    static std::mutex _bufferPoolMutex;
+    static std::vector<std::vector<uint8_t>> _bufferPool;
+
+    static std::vector<uint8_t> AcquireBuffer() {
+        {
+            std::lock_guard<std::mutex> lock(_bufferPoolMutex);
+            if (!_bufferPool.empty()) {
+                auto buffer = std::move(_bufferPool.back());
+                _bufferPool.pop_back();
+                return buffer;
+            }
+        }
+
+        std::vector<uint8_t> buffer;
+        buffer.reserve(FileView::MapThreshold);
+        return buffer;
+    }
+
+    static void ReturnBuffer(std::vector<uint8_t>&& buffer) {
+        if (buffer.capacity() == 0) return;
+        buffer.clear();
+        std::lock_guard<std::mutex> lock(_bufferPoolMutex);
+        if (_bufferPool.size() < MaxPooledBuffers) _bufferPool.emplace_back(std::move(buffer));
+    }
+
+    std::optional<FileView> FileView::Open(std::filesystem::path const& path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return std::nullopt;
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+            ::close(fd);
+            return std::nullopt;
+        }
+
+        FileView view;
+        auto size = static_cast<size_t>(info.st_size);
+        if (size >= MapThreshold) {
+            auto mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (mapping == MAP_FAILED) {
+                ERROR("Failed to map file {}: {}", path.string(), std::strerror(errno));
+                return std::nullopt;
+            }
+
+            view._mapping = mapping;
+            view._data = static_cast<uint8_t const*>(mapping);
+            view._size = size;
+            return view;
+        }
+
+        view._buffer = AcquireBuffer();
+        view._buffer.resize(size);
+        size_t offset = 0;
+        while (offset < size) {
+            auto result = ::read(fd, view._buffer.data() + offset, size - offset);
+            if (result < 0 && errno == EINTR) continue;
+            // the file shrunk while reading, keep what was there
+            if (result <= 0) break;
+            offset += result;
+        }
+        ::close(fd);
+
+        view._buffer.resize(offset);
+        view._data = view._buffer.data();
+        view._size = offset;
+        return view;
+    }
+
+    FileView::FileView(FileView&& other) noexcept :
+        _data(std::exchange(other._data, nullptr)),
+        _size(std::exchange(other._size, 0)),
+        _mapping(std::exchange(other._mapping, nullptr)),
+        _buffer(std::move(other._buffer)) {}
+
+    FileView& FileView::operator=(FileView&& other) noexcept {
+        if (this == &other) return *this;
+        Release();
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+        _mapping = std::exchange(other._mapping, nullptr);
+        _buffer = std::move(other._buffer);
+        return *this;
+    }
+
+    FileView::~FileView() {
+        Release();
+    }
+
+    void FileView::Release() {
+        if (_mapping) ::munmap(_mapping, _size);
+        else ReturnBuffer(std::move(_buffer));
+        _mapping = nullptr;
+        _data = nullptr;
+        _size = 0;
+    }
+
+    DetectedEncoding DetectEncoding(std::span<const uint8_t> bytes) {
+        if (bytes.size() >= 3 && bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF) return { TextEncoding::UTF8, 3 };
+        if (bytes.size() >= 2 && bytes[0] == 0xFF && bytes[1] == 0xFE) return { TextEncoding::UTF16LE, 2 };
+        if (bytes.size() >= 2 && bytes[0] == 0xFE && bytes[1] == 0xFF) return { TextEncoding::UTF16BE, 2 };
+
+        if (bytes.size() >= 2) {
+            if (bytes[0] != 0 && bytes[1] == 0) return { TextEncoding::UTF16LE, 0 };
+            if (bytes[0] == 0 && bytes[1] != 0) return { TextEncoding::UTF16BE, 0 };
+        }
+
+        return { TextEncoding::UTF8, 0 };
+    }
+
+    static std::u16string DecodeUTF16(std::span<const uint8_t> bytes, bool bigEndian) {
+        std::u16string text(bytes.size() / 2, u'\0');
+        std::memcpy(text.data(), bytes.data(), text.size() * sizeof(char16_t));
+        if (bigEndian) {
+            for (auto& c : text) c = static_cast<char16_t>((c << 8) | (c >> 8));
+        }
         return text;
     }
 
+    static std::u16string DecodeUTF8(std::string_view text, std::filesystem::path const& path) {
+        std::u16string result;
+        result.reserve(text.size());
+        try {
+            utf8::utf8to16(text.begin(), text.end(), std::back_inserter(result));
+        } catch (utf8::exception const& e) {
+            WARNING("File {} is not valid utf8, replacing invalid characters: {}", path.string(), e.what());
+            std::string fixed;
+            fixed.reserve(text.size());
+            utf8::replace_invalid(text.begin(), text.end(), std::back_inserter(fixed));
+            result.clear();
+            utf8::utf8to16(fixed.begin(), fixed.end(), std::back_inserter(result));
+        }
+        return result;
+    }
+
+    std::u16string ReadText(std::string_view path) {
+        return ReadText(std::filesystem::path(path));
+    }
+
     std::u16string ReadText(std::filesystem::path path) {
-        if(!std::filesystem::exists(path))
-            return u"";
-        std::basic_ifstream<char16_t> fileStream(path, std::ifstream::in);
-        if(!fileStream.is_open())
-            return u"";
-        return std::u16string((std::istreambuf_iterator<char16_t>(fileStream)), std::istreambuf_iterator<char16_t>());
+        auto file = FileView::Open(path);
+        if (!file) return u"";
+
+        auto bytes = file->bytes();
+        auto [encoding, bomSize] = DetectEncoding(bytes);
+        bytes = bytes.subspan(bomSize);
+
+        switch (encoding) {
+            case TextEncoding::UTF16LE: return DecodeUTF16(bytes, false);
+            case TextEncoding::UTF16BE: return DecodeUTF16(bytes, true);
+            default: return DecodeUTF8(file->chars().substr(bomSize), path);
+        }
+    }
+
+    std::string ReadUTF8Text(std::filesystem::path path) {
+        auto file = FileView::Open(path);
+        if (!file) return "";
+
+        auto [encoding, bomSize] = DetectEncoding(file->bytes());
+        if (encoding == TextEncoding::UTF8) return std::string(file->chars().substr(bomSize));
+
+        auto text = DecodeUTF16(file->bytes().subspan(bomSize), encoding == TextEncoding::UTF16BE);
+        return utf8::utf16to8(text);
     }
 
-    const char* ReadBytes(std::string_view path, size_t& size_out) {
-        size_out = 0;
-        if(!fileexists(path))
-            return nullptr;
-        std::ifstream fileStream(path.data(), std::ifstream::in | std::ios::binary | std::ifstream::ate);
-        size_out = fileStream.tellg();
-        if(!fileStream.is_open())
-            return nullptr;
-        char* data = new char[size_out];
-        fileStream.seekg(fileStream.beg);
-        fileStream.read(data, size_out);
-        return data;
+    std::vector<uint8_t> ReadBytes(std::filesystem::path const& path) {
+        auto file = FileView::Open(path);
+        if (!file) return {};
+        auto bytes = file->bytes();
+        return { bytes.begin(), bytes.end() };
     }
 }
@@ -1,17 +1,30 @@
 #include "Utils/Hashing.hpp"
 #include "CustomJSONData.hpp"
 #include "Utils/Cache.hpp"
+#include "Utils/File.hpp"
 #include "logging.hpp"
 #include <filesystem>
 
 #include "libcryptopp/shared/sha.h"
 #include "libcryptopp/shared/hex.h"
-#include "libcryptopp/shared/files.h"
+#include "libcryptopp/shared/filters.h"
 
 using namespace GlobalNamespace;
 using namespace CryptoPP;
 
 namespace SongCore::Utils {
+    /// @brief feeds the contents of the file into the hash filter straight from the mapped file
+    static void HashFile(HashFilter& hashFilter, std::filesystem::path const& path) {
+        auto file = FileView::Open(path);
+        if (!file) {
+            ERROR("GetCustomLevelHash File {} could not be opened", path.string());
+            return;
+        }
+
+        auto bytes = file->bytes();
+        hashFilter.Put(bytes.data(), bytes.size());
+    }
+
     std::optional<std::string> GetCustomLevelHash(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveData) {
         auto start = std::chrono::high_resolution_clock::now();
         std::string hashHex;
@@ -35,10 +48,7 @@ namespace SongCore::Utils {
         std::string hashResult;
         HashFilter hashFilter(hashType, new StringSink(hashResult));
 
-        FileSource fs(infoPath.c_str(), false);
-        fs.Attach(new Redirector(hashFilter));
-        fs.Pump(LWORD_MAX);
-        fs.Detach();
+        HashFile(hashFilter, infoPath);
         for(auto val : saveData->difficultyBeatmapSets) {
             if (!val) continue;
             auto difficultyBeatmaps = val->difficultyBeatmaps;
@@ -49,10 +59,7 @@ namespace SongCore::Utils {
                     ERROR("GetCustomLevelHash File {} did not exist", diffPath.string());
                     continue;
                 }
-                FileSource fs(diffPath.c_str(), false);
-                fs.Attach(new Redirector(hashFilter));
-                fs.Pump(LWORD_MAX);
-                fs.Detach();
+                HashFile(hashFilter, diffPath);
             }
         }
 
@@ -97,15 +104,9 @@ namespace SongCore::Utils {
         std::string hashResult;
         HashFilter hashFilter(hashType, new StringSink(hashResult));
 
-        FileSource fs(infoPath.c_str(), false);
-        fs.Attach(new Redirector(hashFilter));
-        fs.Pump(LWORD_MAX);
-        fs.Detach();
+        HashFile(hashFilter, infoPath);
 
-        FileSource fsAudio(audioPath.c_str(), false);
-        fsAudio.Attach(new Redirector(hashFilter));
-        fsAudio.Pump(LWORD_MAX);
-        fsAudio.Detach();
+        HashFile(hashFilter, audioPath);
 
         for(auto val : saveData->difficultyBeatmaps) {
             if (!val) continue;
@@ -115,20 +116,14 @@ namespace SongCore::Utils {
                 ERROR("GetCustomLevelHash File {} did not exist", diffPath.string());
                 continue;
             }
-            FileSource fs(diffPath.c_str(), false);
-            fs.Attach(new Redirector(hashFilter));
-            fs.Pump(LWORD_MAX);
-            fs.Detach();
+            HashFile(hashFilter, diffPath);
 
             auto lightPath = levelPath / static_cast<std::string>(val->lightshowDataFilename);
             if(!std::filesystem::exists(lightPath)) {
                 ERROR("GetCustomLevelHash Lighting File {} did not exist", diffPath.string());
                 continue;
             }
-            FileSource fsLight(lightPath.c_str(), false);
-            fsLight.Attach(new Redirector(hashFilter));
-            fsLight.Pump(LWORD_MAX);
-            fsLight.Detach();
+            HashFile(hashFilter, lightPath);
         }
 
         hashFilter.MessageEnd();
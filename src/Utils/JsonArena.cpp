@@ -0,0 +1,113 @@
+#include "Utils/JsonArena.hpp"
+#include "Utils/Errors.hpp"
+#include "beatsaber-hook/shared/rapidjson/include/rapidjson/stringbuffer.h"
+#include "beatsaber-hook/shared/rapidjson/include/rapidjson/writer.h"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+
+namespace SongCore::Utils {
+    using Allocator = rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator>;
+    using Document = SongCore::CustomJSONData::DocumentUTF8;
+
+    /// @brief per thread scratch memory for parsing. only the block grows, so after a few levels parsing stops hitting malloc for the DOM
+    struct ParseArena {
+        static constexpr size_t InitialSize = 64 * 1024;
+
+        std::unique_ptr<char[]> block;
+        size_t blockSize = 0;
+        std::optional<Allocator> allocator;
+
+        /// @brief makes sure the block can hold at least size bytes, and clears anything left from the previous parse
+        Allocator& Reset(size_t size) {
+            if (!allocator || size > blockSize) {
+                allocator.reset();
+                blockSize = std::max(blockSize * 2, std::max(size, InitialSize));
+                block = std::make_unique<char[]>(blockSize);
+                allocator.emplace(block.get(), blockSize);
+            } else {
+                allocator->Clear();
+            }
+            return *allocator;
+        }
+    };
+
+    /// @brief a document and the single block its allocator lives in, destroyed in reverse order
+    struct CompactDocument {
+        std::unique_ptr<char[]> block;
+        Allocator allocator;
+        Document document;
+
+        explicit CompactDocument(size_t size) : block(std::make_unique<char[]>(size)), allocator(block.get(), size), document(&allocator) {}
+    };
+
+    /// @brief room for the allocator bookkeeping in front of the copied values
+    static constexpr size_t CompactOverhead = 256;
+
+    /// @brief how many bytes CopyFrom allocates for the value. strings are counted whole even if they end up stored inline,
+    /// which only ever overestimates, while in situ strings never show up in the scratch allocator's size
+    static size_t CopiedSize(Document::ValueType const& value) {
+        if (value.IsString()) return RAPIDJSON_ALIGN(value.GetStringLength() + 1);
+        if (value.IsArray()) {
+            size_t size = RAPIDJSON_ALIGN(value.Size() * sizeof(Document::ValueType));
+            for (auto const& element : value.GetArray()) size += CopiedSize(element);
+            return size;
+        }
+        if (value.IsObject()) {
+            size_t size = RAPIDJSON_ALIGN(value.MemberCount() * sizeof(Document::ValueType::Member));
+            for (auto const& member : value.GetObject()) size += CopiedSize(member.name) + CopiedSize(member.value);
+            return size;
+        }
+        return 0;
+    }
+
+    /// @brief parses with parse into the calling thread's arena, and compacts the result
+    template<typename ParseFunc>
+    static std::shared_ptr<Document> ParseIntoArena(size_t textSize, ParseFunc&& parse) {
+        thread_local ParseArena arena;
+        // the DOM is usually about as big as the text, start there so most documents fit the block
+        auto& scratchAllocator = arena.Reset(textSize * 2);
+
+        std::shared_ptr<Document> result;
+        {
+            Document scratch(&scratchAllocator);
+            if (!parse(scratch)) return nullptr;
+
+            // const strings point into the in situ buffer, so they get copied as well and the block is sized for everything that gets copied
+            auto compact = std::make_shared<CompactDocument>(CopiedSize(scratch) + CompactOverhead);
+            compact->document.CopyFrom(scratch, compact->allocator, true);
+            result = std::shared_ptr<Document>(compact, &compact->document);
+        }
+
+        // grow the block for next time if this document spilled into extra chunks
+        if (scratchAllocator.Capacity() > arena.blockSize) arena.Reset(scratchAllocator.Capacity());
+        return result;
+    }
+
+    std::shared_ptr<Document> ParseCompactDocument(std::string_view json, std::string_view context) {
+        return ParseIntoArena(json.size(), [&](Document& scratch) {
+            scratch.Parse(json.data(), json.size());
+            if (!scratch.HasParseError()) return true;
+            PrintJSONError(scratch, context, json);
+            return false;
+        });
+    }
+
+    std::shared_ptr<Document> ParseCompactDocumentInsitu(std::string& json, std::string_view context) {
+        return ParseIntoArena(json.size(), [&](Document& scratch) {
+            scratch.ParseInsitu(json.data());
+            if (!scratch.HasParseError()) return true;
+            // the text around the error may already be overwritten, but the offset is still right
+            PrintJSONError(scratch, context, std::string_view(json));
+            return false;
+        });
+    }
+
+    std::string WriteJson(SongCore::CustomJSONData::ValueUTF8 const& value) {
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        value.Accept(writer);
+        return std::string(buffer.GetString(), buffer.GetSize());
+    }
+}
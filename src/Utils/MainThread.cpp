@@ -0,0 +1,23 @@
+#include "Utils/MainThread.hpp"
+
+#include "bsml/shared/BSML/MainThreadScheduler.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace SongCore::Utils {
+    static std::atomic<std::thread::id> _mainThreadId;
+
+    void SetMainThread() {
+        _mainThreadId.store(std::this_thread::get_id(), std::memory_order_release);
+    }
+
+    bool IsMainThread() {
+        return _mainThreadId.load(std::memory_order_acquire) == std::this_thread::get_id();
+    }
+
+    void RunOnMainThreadDetached(std::function<void()> func) {
+        if (IsMainThread()) func();
+        else BSML::MainThreadScheduler::Schedule(std::move(func));
+    }
+}
@@ -1,7 +1,7 @@
 #include "Utils/SaveDataVersion.hpp"
+#include "Utils/File.hpp"
 #include "logging.hpp"
 #include <regex>
-#include <fstream>
 
 namespace SongCore {
     Version Version::noVersion(0, 0, 0);
@@ -30,13 +30,10 @@ namespace SongCore {
     }
 
     Version VersionFromFilePath(std::filesystem::path const& filePath) {
-        if (!std::filesystem::exists(filePath)) return Version::noVersion;
-        std::ifstream file(filePath, std::ios::ate);
-        auto len = std::min<std::size_t>(file.tellg(), 50);
-        file.seekg(0, std::ios::beg);
-        std::string startOfFile(len, 0);
-        file.read(startOfFile.data(), len);
-        return GetVersion(startOfFile);
+        auto file = Utils::FileView::Open(filePath);
+        if (!file) return Version::noVersion;
+        auto chars = file->chars();
+        return GetVersion(std::string(chars.substr(Utils::DetectEncoding(file->bytes()).bomSize, 50)));
     }
 
     Version VersionFromFileData(std::string const& data) {
@@ -0,0 +1,167 @@
+#include "Utils/SortKey.hpp"
+
+#include "utf8.h"
+
+#include <bit>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+namespace SongCore::Utils {
+    // base letters for U+00C0 - U+00FF, 0 means the codepoint is kept as is
+    static constexpr char latin1Supplement[] =
+        "aaaaaaaceeeeiiii" "dnooooo\0ouuuuy\0s"
+        "aaaaaaaceeeeiiii" "dnooooo\0ouuuuy\0y";
+
+    struct FoldRange {
+        char16_t first;
+        char16_t last;
+        char base;
+    };
+
+    // base letters for Latin Extended-A (U+0100 - U+017F)
+    static constexpr FoldRange latinExtendedA[] = {
+        {0x0100, 0x0105, 'a'}, {0x0106, 0x010D, 'c'}, {0x010E, 0x0111, 'd'}, {0x0112, 0x011B, 'e'},
+        {0x011C, 0x0123, 'g'}, {0x0124, 0x0127, 'h'}, {0x0128, 0x0133, 'i'}, {0x0134, 0x0135, 'j'},
+        {0x0136, 0x0138, 'k'}, {0x0139, 0x0142, 'l'}, {0x0143, 0x014B, 'n'}, {0x014C, 0x0153, 'o'},
+        {0x0154, 0x0159, 'r'}, {0x015A, 0x0161, 's'}, {0x0162, 0x0167, 't'}, {0x0168, 0x0173, 'u'},
+        {0x0174, 0x0175, 'w'}, {0x0176, 0x0178, 'y'}, {0x0179, 0x017E, 'z'}, {0x017F, 0x017F, 's'},
+    };
+
+    static uint32_t FoldCodepoint(uint32_t cp) {
+        // fullwidth ascii variants sort with their ascii counterpart
+        if (cp >= 0xFF01 && cp <= 0xFF5E) cp -= 0xFEE0;
+
+        if (cp < 0x80) {
+            if (cp >= 'A' && cp <= 'Z') return cp + ('a' - 'A');
+            return cp;
+        }
+
+        if (cp >= 0xC0 && cp <= 0xFF) {
+            auto base = latin1Supplement[cp - 0xC0];
+            return base ? base : cp;
+        }
+
+        if (cp >= 0x0100 && cp <= 0x017F) {
+            for (auto const& range : latinExtendedA) {
+                if (cp >= range.first && cp <= range.last) return range.base;
+            }
+            return cp;
+        }
+
+        // greek and cyrillic capitals
+        if (cp >= 0x0391 && cp <= 0x03A9) return cp + 0x20;
+        if (cp >= 0x0410 && cp <= 0x042F) return cp + 0x20;
+        if (cp >= 0x0400 && cp <= 0x040F) return cp + 0x50;
+
+        return cp;
+    }
+
+    static void AppendSortKey(std::u16string_view text, std::string& out) {
+        auto itr = text.begin();
+        auto end = text.end();
+
+        // leading whitespace should not influence the order
+        while (itr != end && (*itr == u' ' || *itr == u'\t')) itr++;
+
+        auto inserter = std::back_inserter(out);
+        while (itr != end) {
+            uint32_t cp = *itr++;
+            if (cp >= 0xD800 && cp <= 0xDBFF && itr != end && *itr >= 0xDC00 && *itr <= 0xDFFF) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (*itr++ - 0xDC00);
+            } else if (cp >= 0xD800 && cp <= 0xDFFF) {
+                // lone surrogate, not encodable as utf8
+                cp = 0xFFFD;
+            }
+
+            utf8::unchecked::append(FoldCodepoint(cp), inserter);
+        }
+    }
+
+    std::string MakeSortKey(std::u16string_view text) {
+        std::string key;
+        key.reserve(text.size());
+        AppendSortKey(text, key);
+        return key;
+    }
+
+    std::string MakeSortKey(std::span<StringW const> texts) {
+        std::string key;
+        for (auto const& text : texts) {
+            if (!text) continue;
+            if (!key.empty()) key.push_back('\x01');
+            AppendSortKey(static_cast<std::u16string_view>(text), key);
+        }
+        return key;
+    }
+
+    static void AppendBigEndian(uint64_t value, size_t byteCount, std::string& out) {
+        for (size_t i = byteCount; i > 0; i--) {
+            out.push_back(static_cast<char>((value >> ((i - 1) * 8)) & 0xFF));
+        }
+    }
+
+    std::string MakeSortKey(float value) {
+        if (value != value) value = 0; // NaN
+        auto bits = std::bit_cast<uint32_t>(value);
+        // flip the sign bit for positive values, and all bits for negative values so unsigned order matches float order
+        bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+
+        std::string key;
+        AppendBigEndian(bits, sizeof(bits), key);
+        return key;
+    }
+
+    std::string MakeDateSortKey(int64_t timestamp) {
+        // invert so newer timestamps sort first
+        auto bits = ~(static_cast<uint64_t>(timestamp) ^ 0x8000000000000000ull);
+
+        std::string key;
+        AppendBigEndian(bits, sizeof(bits), key);
+        return key;
+    }
+
+    std::string MakeSortKey(GlobalNamespace::BeatmapLevel* level, SongLoader::LevelSortField field) {
+        using enum SongLoader::LevelSortField;
+        switch (field) {
+            case SongName: {
+                auto songName = level->songName;
+                return songName ? MakeSortKey(static_cast<std::u16string_view>(songName)) : std::string();
+            }
+            case SongAuthorName: {
+                auto songAuthorName = level->songAuthorName;
+                return songAuthorName ? MakeSortKey(static_cast<std::u16string_view>(songAuthorName)) : std::string();
+            }
+            case LevelAuthorName: {
+                auto allMappers = level->allMappers;
+                return allMappers ? MakeSortKey(std::span<StringW const>(allMappers.begin(), allMappers.end())) : std::string();
+            }
+            case BeatsPerMinute: return MakeSortKey(level->beatsPerMinute);
+            // non custom levels have no known date, so they go to the back
+            case DateAdded: return MakeDateSortKey(std::numeric_limits<int64_t>::min());
+        }
+        return {};
+    }
+
+    std::optional<SongLoader::LevelSortField> LevelSortFieldFromString(std::string_view name) {
+        using enum SongLoader::LevelSortField;
+        if (name == "songName") return SongName;
+        if (name == "songAuthorName") return SongAuthorName;
+        if (name == "levelAuthorName") return LevelAuthorName;
+        if (name == "beatsPerMinute") return BeatsPerMinute;
+        if (name == "dateAdded") return DateAdded;
+        return std::nullopt;
+    }
+
+    std::string_view LevelSortFieldToString(SongLoader::LevelSortField field) {
+        using enum SongLoader::LevelSortField;
+        switch (field) {
+            case SongName: return "songName";
+            case SongAuthorName: return "songAuthorName";
+            case LevelAuthorName: return "levelAuthorName";
+            case BeatsPerMinute: return "beatsPerMinute";
+            case DateAdded: return "dateAdded";
+        }
+        return "songName";
+    }
+}
@@ -0,0 +1,121 @@
+#include "Utils/ThreadPool.hpp"
+#include "logging.hpp"
+
+#include "beatsaber-hook/shared/threading.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
+namespace SongCore::Utils {
+    /// @brief the pool the calling thread works for, nullptr on threads that are not pool workers
+    static thread_local ThreadPool const* _workerPool = nullptr;
+    /// @brief id of the job the calling worker is running, 0 outside of jobs
+    static thread_local uint64_t _currentJob = 0;
+    static std::atomic<uint64_t> _nextJobId = 1;
+
+    ThreadPool& ThreadPool::Get() {
+        // leave cores for the game's main and render threads. the workers are detached and live as long as the game, so the pool is never destroyed
+        static auto pool = new ThreadPool(std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 2, 4));
+        return *pool;
+    }
+
+    ThreadPool::ThreadPool(size_t threadCount) : _threadCount(std::max<size_t>(threadCount, 1)) {}
+
+    void ThreadPool::Enqueue(std::function<void()> work, Lane lane) {
+        {
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            if (!_started) StartThreads();
+            _lanes[static_cast<size_t>(lane)].emplace_back(std::move(work), IsWorkerThread() ? _currentJob : 0);
+        }
+        // waking a single thread could pick the UI worker for work it won't take, or a helper, so wake them all
+        _queueCondition.notify_all();
+    }
+
+    void ThreadPool::StartThreads() {
+        _started = true;
+        il2cpp_thread(&ThreadPool::WorkerLoop, this, true).detach();
+        for (size_t i = 0; i < _threadCount; i++) {
+            il2cpp_thread(&ThreadPool::WorkerLoop, this, false).detach();
+        }
+    }
+
+    bool ThreadPool::IsWorkerThread() const {
+        return _workerPool == this;
+    }
+
+    std::function<void()> ThreadPool::TryPop(bool uiOnly) {
+        for (auto& lane : _lanes) {
+            if (!lane.empty()) {
+                auto work = std::move(lane.front().work);
+                lane.pop_front();
+                return work;
+            }
+            if (uiOnly) break;
+        }
+        return {};
+    }
+
+    std::function<void()> ThreadPool::TryPopChild(uint64_t parent) {
+        if (parent == 0) return {};
+        for (auto& lane : _lanes) {
+            auto itr = std::find_if(lane.begin(), lane.end(), [parent](auto const& queued) { return queued.parent == parent; });
+            if (itr == lane.end()) continue;
+
+            auto work = std::move(itr->work);
+            lane.erase(itr);
+            return work;
+        }
+        return {};
+    }
+
+    void ThreadPool::Run(std::function<void()>& work) {
+        // every job gets its own id, so what it queues can be told apart from what the job around it queued
+        auto outerJob = _currentJob;
+        _currentJob = _nextJobId.fetch_add(1, std::memory_order_relaxed);
+
+        try {
+            work();
+        } catch (std::exception const& e) {
+            ERROR("Caught exception of type {} on a worker thread, what: {}", typeid(e).name(), e.what());
+        } catch (...) {
+            ERROR("Caught exception of unknown type (current_exception typeid: {}) on a worker thread", typeid(std::current_exception()).name());
+        }
+        _currentJob = outerJob;
+
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        if (_waitingHelpers > 0) _queueCondition.notify_all();
+    }
+
+    void ThreadPool::WorkerLoop(bool uiOnly) {
+        _workerPool = this;
+
+        while (true) {
+            std::function<void()> work;
+            {
+                std::unique_lock<std::mutex> lock(_queueMutex);
+                _queueCondition.wait(lock, [&](){ return (work = TryPop(uiOnly)) != nullptr; });
+            }
+
+            Run(work);
+        }
+    }
+
+    void ThreadPool::HelpUntil(std::function<bool()> done) {
+        // only the work this job queued itself is safe to run here, anything else may wait on a job further down this stack
+        auto job = _currentJob;
+        while (true) {
+            std::function<void()> work;
+            {
+                std::unique_lock<std::mutex> lock(_queueMutex);
+                _waitingHelpers++;
+                _queueCondition.wait(lock, [&](){ return done() || (work = TryPopChild(job)) != nullptr; });
+                _waitingHelpers--;
+            }
+
+            if (!work) return;
+            Run(work);
+        }
+    }
+}
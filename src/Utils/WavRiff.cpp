@@ -1,7 +1,8 @@
 #include "Utils/WavRiff.hpp"
+#include "Utils/File.hpp"
 #include "logging.hpp"
 
-#include <fstream>
+#include <cstring>
 
 namespace SongCore::Utils {
     /// @brief wav header format based on https://docs.fileformat.com/audio/wav/
@@ -29,11 +30,15 @@ namespace SongCore::Utils {
     static_assert(sizeof(WavHeader) == 44);
 
     float GetLengthFromWavRiff(std::filesystem::path const& path) {
-        std::ifstream reader(path, std::ios::in | std::ios::binary);
+        auto file = FileView::Open(path);
 
         // parse wav header
         WavHeader header;
-        reader.read((char*)&header, sizeof(WavHeader));
+        if (!file || file->size() < sizeof(WavHeader)) {
+            WARNING("Could not read wav header from {}", path.string());
+            return -1;
+        }
+        std::memcpy(&header, file->bytes().data(), sizeof(WavHeader));
         if (!header) {
             WARNING("Could not parse wav header from {}", path.string());
             return -1;
@@ -19,6 +19,8 @@ void SaveConfig() {
     SET(customSongEnvironmentColors);
     SET(disableOneSaberOverride);
     SET(dontShowSongloaderWarningAgain);
+    SET(levelSortField);
+    SET(keepInfoDocuments);
 
     rapidjson::Value rootCustomLevelPaths;
     rootCustomLevelPaths.SetArray();
@@ -74,6 +76,8 @@ bool LoadConfig() {
     GET(customSongEnvironmentColors);
     GET(disableOneSaberOverride);
     GET(dontShowSongloaderWarningAgain);
+    GET(levelSortField);
+    GET(keepInfoDocuments);
 
     auto RootCustomLevelPathsItr = doc.FindMember("RootCustomLevelPaths");
     if (RootCustomLevelPathsItr != doc.MemberEnd() && RootCustomLevelPathsItr->value.IsArray()) {
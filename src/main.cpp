@@ -12,6 +12,7 @@
 #include "UI/DeleteLevelButton.hpp"
 #include "UI/RefreshSongButton.hpp"
 #include "Utils/Cache.hpp"
+#include "Utils/MainThread.hpp"
 
 #include "UI/ProgressBar.hpp"
 #include "_config.h"
@@ -53,6 +54,7 @@ SONGCORE_EXPORT_FUNC void setup(CModInfo* info) {
 // Called later on in the game loading - a good time to install function hooks
 SONGCORE_EXPORT_FUNC void late_load() {
     i2c::functions::initialize();
+    SongCore::Utils::SetMainThread();
 
     srand(time(nullptr));
     custom_types::Register::AutoRegister();